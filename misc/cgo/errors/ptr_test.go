@@ -233,6 +233,25 @@ var ptrTests = []ptrTest{
 		fail:      true,
 		expensive: true,
 	},
+	{
+		// Passing Go memory that contains a pinned Go pointer is OK.
+		name:    "pinned",
+		c:       `typedef struct s { int *p; } s; void f(s *ps) {}`,
+		imports: []string{"runtime"},
+		body:    `var pin runtime.Pinner; i := new(C.int); pin.Pin(i); C.f(&C.s{i}); pin.Unpin()`,
+		fail:    false,
+	},
+	{
+		// Storing a pinned Go pointer into C memory is OK.
+		name: "barrier-pinned",
+		c: `#include <stdlib.h>
+                    char **f1() { return malloc(sizeof(char*)); }
+                    void f2(char **p) {}`,
+		imports:   []string{"runtime"},
+		body:      `var pin runtime.Pinner; c := new(C.char); pin.Pin(c); p := C.f1(); *p = c; C.f2(p); *p = nil; pin.Unpin()`,
+		fail:      false,
+		expensive: true,
+	},
 	{
 		// Exported functions may not return Go pointers.
 		name: "export1",
@@ -8,49 +8,86 @@
 
 const int MYCONST = 0;
 
+// Width in cells of the columns DoStep works through, so that the
+// three rows it reads for each output row stay in cache for the next.
+#define TILE 1024
+
+// The board has y rows of x cells, row-major.
+
 // Do the actual manipulation of the life board in C.  This could be
 // done easily in Go, we are just using C for demonstration
 // purposes.
 void
-Step(int x, int y, int *a, int *n)
+Step(int workers, int x, int y, int *a, int *n)
 {
 	struct GoStart_return r;
+	int i;
+
+	// Use Go to start a goroutine for each band of rows, then wait
+	// for them all.
+	for(i = 0; i < workers; i++) {
+		r = GoStart(i, x, y, 0, x, y * i / workers, y * (i + 1) / workers, a, n);
+		assert(r.r0 == i && r.r1 == i + 100);	// test multiple returns
+	}
+	for(i = 0; i < workers; i++)
+		GoWait(i);
+}
+
+// Cell (x, y) with bounds checks, for the edges of the board.
+static int
+edge(int xdim, int ydim, int x, int y, int *a)
+{
+	int c, i, j;
+
+	c = 0;
+	for(j = -1; j <= 1; j++) {
+		for(i = -1; i <= 1; i++) {
+			if(x+i >= 0 && x+i < xdim &&
+			   y+j >= 0 && y+j < ydim &&
+			   (i != 0 || j != 0))
+				c += a[(y+j)*xdim + (x+i)] != 0;
+		}
+	}
+	return c == 3 || (c == 2 && a[y*xdim + x] != 0);
+}
+
+// Cells [xstart, xend) of an interior row, whose neighbours are all on
+// the board. The loop has no branches so that the compiler can
+// vectorize it.
+static void
+row(int xstart, int xend, const int *restrict up, const int *restrict mid, const int *restrict down, int *restrict n)
+{
+	int x, c;
 
-	// Use Go to start 4 goroutines each of which handles 1/4 of the
-	// board.
-	r = GoStart(0, x, y, 0, x / 2, 0, y / 2, a, n);
-	assert(r.r0 == 0 && r.r1 == 100);	// test multiple returns
-	r = GoStart(1, x, y, x / 2, x, 0, y / 2, a, n);
-	assert(r.r0 == 1 && r.r1 == 101);	// test multiple returns
-	GoStart(2, x, y, 0, x / 2, y / 2, y, a, n);
-	GoStart(3, x, y, x / 2, x, y / 2, y, a, n);
-	GoWait(0);
-	GoWait(1);
-	GoWait(2);
-	GoWait(3);
+	for(x = xstart; x < xend; x++) {
+		c = (up[x-1] != 0) + (up[x] != 0) + (up[x+1] != 0) +
+			(mid[x-1] != 0) + (mid[x+1] != 0) +
+			(down[x-1] != 0) + (down[x] != 0) + (down[x+1] != 0);
+		n[x] = (c == 3) | ((c == 2) & (mid[x] != 0));
+	}
 }
 
 // The actual computation.  This is called in parallel.
 void
 DoStep(int xdim, int ydim, int xstart, int xend, int ystart, int yend, int *a, int *n)
 {
-	int x, y, c, i, j;
+	int x, y, x0, x1, lo, hi;
 
-	for(x = xstart; x < xend; x++) {
+	for(x0 = xstart; x0 < xend; x0 += TILE) {
+		x1 = x0 + TILE < xend ? x0 + TILE : xend;
+		lo = x0 > 1 ? x0 : 1;
+		hi = x1 < xdim - 1 ? x1 : xdim - 1;
 		for(y = ystart; y < yend; y++) {
-			c = 0;
-			for(i = -1; i <= 1; i++) {
-				for(j = -1; j <= 1; j++) {
-				  if(x+i >= 0 && x+i < xdim &&
-					y+j >= 0 && y+j < ydim &&
-					(i != 0 || j != 0))
-				    c += a[(x+i)*xdim + (y+j)] != 0;
-				}
+			if(y == 0 || y == ydim - 1 || lo >= hi) {
+				for(x = x0; x < x1; x++)
+					n[y*xdim + x] = edge(xdim, ydim, x, y, a);
+				continue;
 			}
-			if(c == 3 || (c == 2 && a[x*xdim + y] != 0))
-				n[x*xdim + y] = 1;
-			else
-				n[x*xdim + y] = 0;
+			for(x = x0; x < lo; x++)
+				n[y*xdim + x] = edge(xdim, ydim, x, y, a);
+			row(lo, hi, a + (y-1)*xdim, a + y*xdim, a + (y+1)*xdim, n + y*xdim);
+			for(x = hi; x < x1; x++)
+				n[y*xdim + x] = edge(xdim, ydim, x, y, a);
 		}
 	}
 }
@@ -6,21 +6,47 @@
 
 package life
 
+// #cgo CFLAGS: -O3
 // #include "life.h"
 import "C"
 
 import "unsafe"
 
+// Run runs gen generations of the board a, which has y rows of x
+// cells, using four goroutines.
 func Run(gen, x, y int, a []int32) {
-	n := make([]int32, x*y)
+	RunWorkers(gen, x, y, 4, a)
+}
+
+// RunWorkers is like Run, but with the given number of goroutines.
+func RunWorkers(gen, x, y, workers int, a []int32) {
+	chans = make([]chan bool, workers)
+	cur, next := a, make([]int32, x*y)
 	for i := 0; i < gen; i++ {
-		C.Step(C.int(x), C.int(y), (*C.int)(unsafe.Pointer(&a[0])), (*C.int)(unsafe.Pointer(&n[0])))
-		copy(a, n)
+		C.Step(C.int(workers), C.int(x), C.int(y), (*C.int)(unsafe.Pointer(&cur[0])), (*C.int)(unsafe.Pointer(&next[0])))
+		cur, next = next, cur
 	}
+	if gen%2 != 0 {
+		copy(a, cur)
+	}
+}
+
+// FanOut makes the calls to Go that Step makes for the given number
+// of goroutines, on an empty board, so that no cells are computed.
+func FanOut(workers int) {
+	var cell C.int
+	chans = make([]chan bool, workers)
+	C.Step(C.int(workers), 0, 0, &cell, &cell)
+}
+
+// StepC computes a generation of the board a, which has y rows of x
+// cells, into n with a single C call and no goroutines.
+func StepC(x, y int, a, n []int32) {
+	C.DoStep(C.int(x), C.int(y), 0, C.int(x), 0, C.int(y), (*C.int)(unsafe.Pointer(&a[0])), (*C.int)(unsafe.Pointer(&n[0])))
 }
 
 // Keep the channels visible from Go.
-var chans [4]chan bool
+var chans []chan bool
 
 //export GoStart
 // Double return value is just for testing.
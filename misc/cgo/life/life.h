@@ -2,6 +2,6 @@
 // Use of this source code is governed by a BSD-style
 // license that can be found in the LICENSE file.
 
-extern void Step(int, int, int *, int *);
+extern void Step(int, int, int, int *, int *);
 extern void DoStep(int, int, int, int, int, int, int *, int *);
 extern const int MYCONST;
@@ -0,0 +1,142 @@
+// skip
+
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// Benchmarks of C code that fans work out to Go goroutines through
+// calls to exported Go functions. The time of BenchmarkStep for a
+// board size and number of workers is roughly that of BenchmarkDoStep
+// for the board divided by the workers, plus that of BenchmarkFanOut
+// for the workers; the last is the cost of the calls between C and Go
+// and of the goroutines.
+//
+//	go test -bench . -life.dims 64,1024 -life.workers 1,2,4,8
+
+package life
+
+import (
+	"flag"
+	"fmt"
+	"math/rand"
+	"strconv"
+	"strings"
+	"testing"
+)
+
+var (
+	dimsFlag    = flag.String("life.dims", "16,256,2048", "comma-separated board dimensions to benchmark")
+	workersFlag = flag.String("life.workers", "1,4,16", "comma-separated worker counts to benchmark")
+)
+
+func ints(tb testing.TB, s string) []int {
+	var r []int
+	for _, f := range strings.Split(s, ",") {
+		n, err := strconv.Atoi(f)
+		if err != nil || n <= 0 {
+			tb.Fatalf("bad number %q in %q", f, s)
+		}
+		r = append(r, n)
+	}
+	return r
+}
+
+func randomBoard(x, y int) []int32 {
+	a := make([]int32, x*y)
+	r := rand.New(rand.NewSource(1))
+	for i := range a {
+		// Any nonzero cell is alive.
+		if v := r.Intn(8); v < 3 {
+			a[i] = int32(v)
+		}
+	}
+	return a
+}
+
+// step is the reference implementation of a generation.
+func step(x, y int, a []int32) []int32 {
+	n := make([]int32, x*y)
+	for j := 0; j < y; j++ {
+		for i := 0; i < x; i++ {
+			c := 0
+			for dj := -1; dj <= 1; dj++ {
+				for di := -1; di <= 1; di++ {
+					ii, jj := i+di, j+dj
+					if (di != 0 || dj != 0) && ii >= 0 && ii < x && jj >= 0 && jj < y && a[jj*x+ii] != 0 {
+						c++
+					}
+				}
+			}
+			if c == 3 || c == 2 && a[j*x+i] != 0 {
+				n[j*x+i] = 1
+			}
+		}
+	}
+	return n
+}
+
+func TestRun(t *testing.T) {
+	const gen = 3
+	for _, size := range []struct{ x, y int }{
+		{1, 1}, {2, 3}, {3, 5}, {17, 9}, {64, 64}, {1030, 7}, {2100, 3}, {5, 40},
+	} {
+		for _, workers := range []int{1, 3, 4, 8} {
+			want := randomBoard(size.x, size.y)
+			got := append([]int32(nil), want...)
+			for i := 0; i < gen; i++ {
+				want = step(size.x, size.y, want)
+			}
+			RunWorkers(gen, size.x, size.y, workers, got)
+			for i := range got {
+				if got[i] != want[i] {
+					t.Errorf("%dx%d board with %d workers: cell (%d, %d) = %d, want %d",
+						size.x, size.y, workers, i%size.x, i/size.x, got[i], want[i])
+					break
+				}
+			}
+		}
+	}
+}
+
+// BenchmarkStep measures a generation computed by goroutines started
+// from C. MB/s is millions of cells per second.
+func BenchmarkStep(b *testing.B) {
+	for _, dim := range ints(b, *dimsFlag) {
+		for _, workers := range ints(b, *workersFlag) {
+			b.Run(fmt.Sprintf("dim=%d/workers=%d", dim, workers), func(b *testing.B) {
+				a := randomBoard(dim, dim)
+				b.SetBytes(int64(dim * dim))
+				b.ResetTimer()
+				RunWorkers(b.N, dim, dim, workers, a)
+			})
+		}
+	}
+}
+
+// BenchmarkDoStep measures a generation computed by a single C call.
+// MB/s is millions of cells per second.
+func BenchmarkDoStep(b *testing.B) {
+	for _, dim := range ints(b, *dimsFlag) {
+		b.Run(fmt.Sprintf("dim=%d", dim), func(b *testing.B) {
+			a, n := randomBoard(dim, dim), make([]int32, dim*dim)
+			b.SetBytes(int64(dim * dim))
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				StepC(dim, dim, a, n)
+				a, n = n, a
+			}
+		})
+	}
+}
+
+// BenchmarkFanOut measures starting workers goroutines from C and
+// waiting for them, with no work to do.
+func BenchmarkFanOut(b *testing.B) {
+	for _, workers := range ints(b, *workersFlag) {
+		b.Run(fmt.Sprintf("workers=%d", workers), func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				FanOut(workers)
+			}
+		})
+	}
+}
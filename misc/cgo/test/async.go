@@ -0,0 +1,91 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// +build !windows
+
+package cgotest
+
+// Calls to C functions marked with a #cgo async directive.
+
+/*
+#cgo async asyncAdd asyncErrno asyncSleep asyncThread
+
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+
+static int asyncActive, asyncMaxActive;
+
+static int asyncAdd(int a, int b) { return a + b; }
+
+static int asyncErrno(int e) {
+	errno = e;
+	return -1;
+}
+
+static void asyncSleep(int usec) {
+	int n, m;
+
+	n = __sync_add_and_fetch(&asyncActive, 1);
+	while ((m = asyncMaxActive) < n && !__sync_bool_compare_and_swap(&asyncMaxActive, m, n)) {
+	}
+	usleep(usec);
+	__sync_sub_and_fetch(&asyncActive, 1);
+}
+
+static int asyncMaxActiveCalls(void) { return asyncMaxActive; }
+
+static unsigned long asyncThread(void) { return (unsigned long)pthread_self(); }
+static unsigned long syncThread(void) { return (unsigned long)pthread_self(); }
+*/
+import "C"
+
+import (
+	"runtime"
+	"sync"
+	"syscall"
+	"testing"
+)
+
+func testAsyncCall(t *testing.T) {
+	if got := C.asyncAdd(2, 3); got != 5 {
+		t.Errorf("asyncAdd(2, 3) = %d, want 5", got)
+	}
+	if _, err := C.asyncErrno(C.EINVAL); err != syscall.EINVAL {
+		t.Errorf("asyncErrno(EINVAL) error = %v, want %v", err, syscall.EINVAL)
+	}
+	if C.asyncThread() == C.syncThread() {
+		t.Error("async call ran on the calling thread")
+	}
+}
+
+// testAsyncCallPool checks that many concurrent async calls share the
+// bounded pool of worker threads.
+func testAsyncCallPool(t *testing.T) {
+	const calls = 64
+	var wg sync.WaitGroup
+	for i := 0; i < calls; i++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			C.asyncSleep(20 * 1000)
+		}()
+	}
+	wg.Wait()
+
+	// 16 is the default of GODEBUG=cgoasyncthreads.
+	if max := C.asyncMaxActiveCalls(); max < 2 || max > 16 {
+		t.Errorf("%d concurrent async calls, want 2 to 16", max)
+	}
+}
+
+// testAsyncCallLocked checks that a goroutine locked to its thread
+// makes an ordinary call on that thread.
+func testAsyncCallLocked(t *testing.T) {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+	if C.asyncThread() != C.syncThread() {
+		t.Error("async call from locked goroutine ran on another thread")
+	}
+}
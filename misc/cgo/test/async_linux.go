@@ -0,0 +1,94 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+package cgotest
+
+/*
+#cgo async benchAsyncSleep
+
+#include <unistd.h>
+
+static void benchAsyncSleep(int usec) { usleep(usec); }
+static void benchPlainSleep(int usec) { usleep(usec); }
+*/
+import "C"
+
+import (
+	"bytes"
+	"io/ioutil"
+	"strconv"
+	"sync"
+	"testing"
+	"time"
+)
+
+// procStatus returns a numeric field of /proc/self/status.
+func procStatus(b *testing.B, field string) int {
+	data, err := ioutil.ReadFile("/proc/self/status")
+	if err != nil {
+		b.Fatal(err)
+	}
+	for _, line := range bytes.Split(data, []byte("\n")) {
+		if f := bytes.Fields(line); len(f) >= 2 && string(f[0]) == field+":" {
+			n, err := strconv.Atoi(string(f[1]))
+			if err != nil {
+				b.Fatal(err)
+			}
+			return n
+		}
+	}
+	b.Fatalf("no %s in /proc/self/status", field)
+	return 0
+}
+
+// benchAsyncCall runs rounds of 1000 goroutines that each make a
+// 10ms C call, as async calls and as plain cgo calls, and reports the
+// thread count and resident memory during the calls and the mean time
+// a call takes, which for async calls includes waiting for a worker.
+// Threads made for plain calls are kept by the runtime, so the async
+// calls are measured first.
+func benchAsyncCall(b *testing.B) {
+	const (
+		goroutines = 1000
+		sleep      = 10 * time.Millisecond
+	)
+	for _, bc := range []struct {
+		name  string
+		sleep func(C.int)
+	}{
+		{"async", func(usec C.int) { C.benchAsyncSleep(usec) }},
+		{"plain", func(usec C.int) { C.benchPlainSleep(usec) }},
+	} {
+		b.Run(bc.name, func(b *testing.B) {
+			var threads, rss int
+			var total time.Duration
+			var mu sync.Mutex
+			for i := 0; i < b.N; i++ {
+				var wg sync.WaitGroup
+				for j := 0; j < goroutines; j++ {
+					wg.Add(1)
+					go func() {
+						defer wg.Done()
+						start := time.Now()
+						bc.sleep(C.int(sleep / time.Microsecond))
+						d := time.Since(start)
+						mu.Lock()
+						total += d
+						mu.Unlock()
+					}()
+				}
+				time.Sleep(sleep / 2)
+				if n := procStatus(b, "Threads"); n > threads {
+					threads = n
+				}
+				if n := procStatus(b, "VmRSS"); n > rss {
+					rss = n
+				}
+				wg.Wait()
+			}
+			b.Logf("N=%d: %d threads, %d kB RSS, %v per call",
+				b.N, threads, rss, total/time.Duration(b.N*goroutines))
+		})
+	}
+}
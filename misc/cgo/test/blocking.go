@@ -0,0 +1,114 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// +build !windows
+
+package cgotest
+
+// Calls to C functions marked with a #cgo blocking directive.
+
+/*
+#cgo blocking blockingSleep blockingWait
+
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+static void blockingSleep(int usec) { usleep(usec); }
+static void plainSleep(int usec) { usleep(usec); }
+
+static int blockingRan;
+
+static void resetBlockingRan(void) { __atomic_store_n(&blockingRan, 0, __ATOMIC_RELEASE); }
+static void markBlockingRan(void) { __atomic_store_n(&blockingRan, 1, __ATOMIC_RELEASE); }
+
+// blockingWait waits for up to nsec nanoseconds for markBlockingRan
+// to be called, yielding the CPU meanwhile, and reports whether it was.
+static int blockingWait(long long nsec) {
+	struct timespec start, now;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (;;) {
+		if (__atomic_load_n(&blockingRan, __ATOMIC_ACQUIRE)) {
+			return 1;
+		}
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		if ((now.tv_sec - start.tv_sec) * 1000000000LL + (now.tv_nsec - start.tv_nsec) > nsec) {
+			return 0;
+		}
+		sched_yield();
+	}
+}
+*/
+import "C"
+
+import (
+	"runtime"
+	"sync/atomic"
+	"testing"
+	"time"
+)
+
+// testBlockingCall checks that, with a single P, another goroutine runs
+// within 10µs of a blocking C call starting. sysmon only retakes the P
+// of an ordinary C call after the call has been seen in C for a whole
+// sysmon tick, at least 20µs, so only an immediate handoff can pass.
+func testBlockingCall(t *testing.T) {
+	defer runtime.GOMAXPROCS(runtime.GOMAXPROCS(1))
+
+	for i := 0; i < 10; i++ {
+		C.resetBlockingRan()
+		done := make(chan bool)
+		go func() {
+			C.markBlockingRan()
+			done <- true
+		}()
+		ran := C.blockingWait(10 * 1000)
+		<-done
+		if ran != 0 {
+			return
+		}
+	}
+	t.Error("goroutine did not run within 10µs of a blocking C call starting")
+}
+
+// benchBlockingCall measures how long a runnable goroutine waits for the
+// only P while the goroutine holding it sleeps in C, with and without
+// the #cgo blocking directive. Other goroutines keep the CPU busy.
+func benchBlockingCall(b *testing.B) {
+	for _, bc := range []struct {
+		name  string
+		sleep func(C.int)
+	}{
+		{"plain", func(usec C.int) { C.plainSleep(usec) }},
+		{"blocking", func(usec C.int) { C.blockingSleep(usec) }},
+	} {
+		b.Run(bc.name, func(b *testing.B) {
+			defer runtime.GOMAXPROCS(runtime.GOMAXPROCS(1))
+
+			var stop int32
+			for i := 0; i < 2; i++ {
+				go func() {
+					for atomic.LoadInt32(&stop) == 0 {
+						runtime.Gosched()
+					}
+				}()
+			}
+
+			var wait time.Duration
+			done := make(chan bool)
+			for i := 0; i < b.N; i++ {
+				start := time.Now()
+				go func() {
+					wait += time.Since(start)
+					done <- true
+				}()
+				bc.sleep(1000)
+				<-done
+			}
+			atomic.StoreInt32(&stop, 1)
+			b.Logf("%d calls: average wait %v", b.N, wait/time.Duration(b.N))
+		})
+	}
+}
@@ -10,3 +10,5 @@ func TestSetgid(t *testing.T)  { testSetgid(t) }
 func Test6997(t *testing.T)    { test6997(t) }
 func TestBuildID(t *testing.T) { testBuildID(t) }
 func Test9400(t *testing.T)    { test9400(t) }
+
+func BenchmarkAsyncCall(b *testing.B) { benchAsyncCall(b) }
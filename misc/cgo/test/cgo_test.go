@@ -28,6 +28,7 @@ func TestBlocking(t *testing.T)              { testBlocking(t) }
 func Test1328(t *testing.T)                  { test1328(t) }
 func TestParallelSleep(t *testing.T)         { testParallelSleep(t) }
 func TestSetEnv(t *testing.T)                { testSetEnv(t) }
+func TestUpdateEnv(t *testing.T)             { testUpdateEnv(t) }
 func TestHelpers(t *testing.T)               { testHelpers(t) }
 func TestLibgcc(t *testing.T)                { testLibgcc(t) }
 func Test1635(t *testing.T)                  { test1635(t) }
@@ -90,8 +91,14 @@ func Test22906(t *testing.T)                 { test22906(t) }
 func Test24206(t *testing.T)                 { test24206(t) }
 func Test25143(t *testing.T)                 { test25143(t) }
 func Test23356(t *testing.T)                 { test23356(t) }
+func TestSharedStruct(t *testing.T)          { testSharedStruct(t) }
 func Test26066(t *testing.T)                 { test26066(t) }
 func Test26213(t *testing.T)                 { test26213(t) }
+func TestPinner(t *testing.T)                { testPinner(t) }
+func TestPinnerRequired(t *testing.T)        { testPinnerRequired(t) }
 
-func BenchmarkCgoCall(b *testing.B)  { benchCgoCall(b) }
-func BenchmarkGoString(b *testing.B) { benchGoString(b) }
+func BenchmarkCgoCall(b *testing.B)    { benchCgoCall(b) }
+func BenchmarkGoString(b *testing.B)   { benchGoString(b) }
+func BenchmarkExportArgs(b *testing.B) { benchExportArgs(b) }
+func BenchmarkPinner(b *testing.B)     { benchPinner(b) }
+func BenchmarkUpdateEnv(b *testing.B)  { benchUpdateEnv(b) }
@@ -8,6 +8,14 @@ package cgotest
 
 import "testing"
 
-func TestSigaltstack(t *testing.T) { testSigaltstack(t) }
-func TestSigprocmask(t *testing.T) { testSigprocmask(t) }
-func Test18146(t *testing.T)       { test18146(t) }
+func TestSigaltstack(t *testing.T)     { testSigaltstack(t) }
+func TestSigprocmask(t *testing.T)     { testSigprocmask(t) }
+func Test18146(t *testing.T)           { test18146(t) }
+func TestBlockingCall(t *testing.T)    { testBlockingCall(t) }
+func TestAsyncCall(t *testing.T)       { testAsyncCall(t) }
+func TestAsyncCallPool(t *testing.T)   { testAsyncCallPool(t) }
+func TestAsyncCallLocked(t *testing.T) { testAsyncCallLocked(t) }
+func TestNewCallback(t *testing.T)     { testNewCallback(t) }
+
+func BenchmarkBlockingCall(b *testing.B) { benchBlockingCall(b) }
+func BenchmarkNewCallback(b *testing.B)  { benchNewCallback(b) }
@@ -6,11 +6,23 @@ package cgotest
 
 /*
 #include <stdlib.h>
+
+#ifdef __APPLE__
+#include <crt_externs.h>
+static char **cgoEnviron(void) { return *_NSGetEnviron(); }
+#elif !defined(_WIN32)
+extern char **environ;
+static char **cgoEnviron(void) { return environ; }
+#else
+static char **cgoEnviron(void) { return NULL; }
+#endif
 */
 import "C"
 import (
+	"fmt"
 	"os"
 	"runtime"
+	"strconv"
 	"testing"
 	"unsafe"
 )
@@ -39,3 +51,93 @@ func testSetEnv(t *testing.T) {
 		t.Fatalf("getenv() = %q; want %q", vs, val)
 	}
 }
+
+func cgetenv(key string) (string, bool) {
+	keyc := C.CString(key)
+	defer C.free(unsafe.Pointer(keyc))
+	v := C.getenv(keyc)
+	if v == nil {
+		return "", false
+	}
+	return C.GoString(v), true
+}
+
+func testUpdateEnv(t *testing.T) {
+	if runtime.GOOS == "windows" {
+		t.Skip("C environment is a copy on windows; see testSetEnv")
+	}
+	const (
+		keep  = "CGO_OS_TEST_UPDATE_KEEP"
+		unset = "CGO_OS_TEST_UPDATE_UNSET"
+		reset = "CGO_OS_TEST_UPDATE_RESET"
+		set   = "CGO_OS_TEST_UPDATE_SET"
+	)
+	defer os.Unsetenv(keep)
+	defer os.Unsetenv(reset)
+	defer os.Unsetenv(set)
+	os.Setenv(keep, "keep")
+	os.Setenv(unset, "unset")
+	os.Setenv(reset, "old")
+
+	err := os.UpdateEnv(map[string]string{reset: "new", set: "set"}, []string{unset, reset})
+	if err != nil {
+		t.Fatal(err)
+	}
+	for key, want := range map[string]string{keep: "keep", reset: "new", set: "set"} {
+		if v, ok := cgetenv(key); !ok || v != want {
+			t.Errorf("getenv(%q) = %q, %v; want %q, true", key, v, ok, want)
+		}
+	}
+	if v, ok := cgetenv(unset); ok {
+		t.Errorf("getenv(%q) = %q after UpdateEnv unset it", unset, v)
+	}
+
+	// C setenv must keep working on the environ UpdateEnv made.
+	os.Setenv(keep, "again")
+	if v, _ := cgetenv(keep); v != "again" {
+		t.Errorf("getenv(%q) = %q after Setenv; want %q", keep, v, "again")
+	}
+
+	// Repeating an update reuses the environ array that UpdateEnv
+	// made, rather than leaking a new one each time.
+	arrays := make(map[unsafe.Pointer]bool)
+	for i := 0; i < 100; i++ {
+		os.UpdateEnv(map[string]string{set: strconv.Itoa(i)}, nil)
+		arrays[unsafe.Pointer(C.cgoEnviron())] = true
+	}
+	if len(arrays) > 2 {
+		t.Errorf("100 calls to UpdateEnv made %d environ arrays", len(arrays))
+	}
+}
+
+// benchUpdateEnv compares importing many variables, as a program might
+// at startup, with Setenv for each and with one call to UpdateEnv.
+func benchUpdateEnv(b *testing.B) {
+	const n = 5000
+	vars := make(map[string]string, n)
+	var keys []string
+	for i := 0; i < n; i++ {
+		key := fmt.Sprintf("CGO_BENCH_UPDATEENV_%d", i)
+		vars[key] = strconv.Itoa(i)
+		keys = append(keys, key)
+	}
+	defer os.UpdateEnv(nil, keys)
+	b.Run("Setenv", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			for key, value := range vars {
+				os.Setenv(key, value)
+			}
+			b.StopTimer()
+			os.UpdateEnv(nil, keys)
+			b.StartTimer()
+		}
+	})
+	b.Run("UpdateEnv", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			os.UpdateEnv(vars, nil)
+			b.StopTimer()
+			os.UpdateEnv(nil, keys)
+			b.StartTimer()
+		}
+	})
+}
@@ -0,0 +1,62 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+package cgotest
+
+// Calls from C to exported Go functions with scalar arguments.
+
+// void callExportArgs(int, long);
+import "C"
+
+import (
+	"fmt"
+	"testing"
+)
+
+var exportArgsSum int
+
+//export exportArgs0
+func exportArgs0() {}
+
+//export exportArgs1
+func exportArgs1(a int) { exportArgsSum += a }
+
+//export exportArgs2
+func exportArgs2(a, b int) { exportArgsSum += a + b }
+
+//export exportArgs3
+func exportArgs3(a, b int, c float64) { exportArgsSum += a + b + int(c) }
+
+//export exportArgs4
+func exportArgs4(a, b int, c float64, d int32) int {
+	return a + b + int(c) + int(d)
+}
+
+//export exportArgs5
+func exportArgs5(a, b int, c float64, d int32, e uint8) int {
+	return a + b + int(c) + int(d) + int(e)
+}
+
+//export exportArgs6
+func exportArgs6(a, b int, c float64, d int32, e uint8, f uintptr) int {
+	return a + b + int(c) + int(d) + int(e) + int(f)
+}
+
+//export exportArgs7
+func exportArgs7(a, b int, c float64, d int32, e uint8, f uintptr, g int64) int {
+	return a + b + int(c) + int(d) + int(e) + int(f) + int(g)
+}
+
+//export exportArgs8
+func exportArgs8(a, b int, c float64, d int32, e uint8, f uintptr, g int64, h float32) int {
+	return a + b + int(c) + int(d) + int(e) + int(f) + int(g) + int(h)
+}
+
+func benchExportArgs(b *testing.B) {
+	for n := 0; n <= 8; n++ {
+		b.Run(fmt.Sprint(n), func(b *testing.B) {
+			C.callExportArgs(C.int(n), C.long(b.N))
+		})
+	}
+}
@@ -0,0 +1,45 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#include "_cgo_export.h"
+
+// callExportArgs calls the exported Go function that takes nargs
+// arguments n times.
+void
+callExportArgs(int nargs, long n)
+{
+	long i;
+
+	for (i = 0; i < n; i++) {
+		switch (nargs) {
+		case 0:
+			exportArgs0();
+			break;
+		case 1:
+			exportArgs1(i);
+			break;
+		case 2:
+			exportArgs2(i, 2);
+			break;
+		case 3:
+			exportArgs3(i, 2, 3.0);
+			break;
+		case 4:
+			exportArgs4(i, 2, 3.0, 4);
+			break;
+		case 5:
+			exportArgs5(i, 2, 3.0, 4, 5);
+			break;
+		case 6:
+			exportArgs6(i, 2, 3.0, 4, 5, 6);
+			break;
+		case 7:
+			exportArgs7(i, 2, 3.0, 4, 5, 6, 7);
+			break;
+		case 8:
+			exportArgs8(i, 2, 3.0, 4, 5, 6, 7, 8.0f);
+			break;
+		}
+	}
+}
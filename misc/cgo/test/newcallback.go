@@ -0,0 +1,157 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// +build !windows
+
+package cgotest
+
+// C function pointers for Go functions made by runtime/cgo.NewCallback.
+
+/*
+#include <stddef.h>
+#include <stdint.h>
+
+void sortInts(int *a, size_t n, uintptr_t cmp);
+void sortIntsHandle(int *a, size_t n, uintptr_t h);
+uintptr_t callFunc6(uintptr_t f);
+uintptr_t callFunc0(uintptr_t f);
+*/
+import "C"
+
+import (
+	"math/rand"
+	"runtime/cgo"
+	"sort"
+	"sync"
+	"testing"
+	"time"
+	"unsafe"
+)
+
+func compareInts(x, y unsafe.Pointer) int {
+	a, b := *(*C.int)(x), *(*C.int)(y)
+	switch {
+	case a < b:
+		return -1
+	case a > b:
+		return 1
+	}
+	return 0
+}
+
+func randomInts(n int) []C.int {
+	r := rand.New(rand.NewSource(1))
+	a := make([]C.int, n)
+	for i := range a {
+		a[i] = C.int(r.Int31())
+	}
+	return a
+}
+
+func testNewCallback(t *testing.T) {
+	a := randomInts(1000)
+	cmp := cgo.NewCallback(compareInts)
+	C.sortInts(&a[0], C.size_t(len(a)), C.uintptr_t(cmp))
+	if !sort.SliceIsSorted(a, func(i, j int) bool { return a[i] < a[j] }) {
+		t.Error("qsort with a NewCallback comparison did not sort")
+	}
+	if again := cgo.NewCallback(compareInts); again != cmp {
+		t.Errorf("NewCallback(compareInts) = %#x, then %#x", cmp, again)
+	}
+
+	k := uintptr(7)
+	f := cgo.NewCallback(func(a, b, c, d, e, f uintptr) uintptr {
+		return a*100000 + b*10000 + c*1000 + d*100 + e*10 + f + k
+	})
+	if got := C.callFunc6(C.uintptr_t(f)); got != 123463 {
+		t.Errorf("six-argument callback returned %d, want 123463", got)
+	}
+	g := cgo.NewCallback(func() uintptr { return k })
+	if g == f {
+		t.Error("different closures got the same callback")
+	}
+	if got := C.callFunc0(C.uintptr_t(g)); got != 7 {
+		t.Errorf("no-argument callback returned %d, want 7", got)
+	}
+
+	for _, fn := range []interface{}{
+		nil,
+		1,
+		func() {},
+		func() int32 { return 0 },
+		func(int8) uintptr { return 0 },
+		func() float64 { return 0 },
+		func(float64) uintptr { return 0 },
+		func(complex64) uintptr { return 0 },
+		func() complex64 { return 0 },
+		func(string) uintptr { return 0 },
+		func(map[int]int) uintptr { return 0 },
+		func(a, b, c, d, e, f, g uintptr) uintptr { return 0 },
+	} {
+		func() {
+			defer func() {
+				if recover() == nil {
+					t.Errorf("NewCallback(%T) did not panic", fn)
+				}
+			}()
+			cgo.NewCallback(fn)
+		}()
+	}
+}
+
+// The handle table a program needs without NewCallback: C passes an
+// integer to an exported Go function, which looks up the Go function
+// to call, as goCallback does.
+var (
+	compareHandleMu    sync.Mutex
+	compareHandleFuncs = map[uintptr]func(x, y unsafe.Pointer) int{}
+)
+
+//export goCompareHandle
+func goCompareHandle(h C.uintptr_t, x, y unsafe.Pointer) C.int {
+	compareHandleMu.Lock()
+	f := compareHandleFuncs[uintptr(h)]
+	compareHandleMu.Unlock()
+	return C.int(f(x, y))
+}
+
+// benchNewCallback sorts 10M C ints with qsort and a Go comparison
+// function, called through a NewCallback pointer and through a handle
+// table and exported function.
+func benchNewCallback(b *testing.B) {
+	const n = 10000000
+	orig := randomInts(n)
+	a := make([]C.int, n)
+
+	var compares int
+	count := func(x, y unsafe.Pointer) int {
+		compares++
+		return compareInts(x, y)
+	}
+	run := func(b *testing.B, sort func()) {
+		compares = 0
+		var elapsed time.Duration
+		for i := 0; i < b.N; i++ {
+			b.StopTimer()
+			copy(a, orig)
+			b.StartTimer()
+			start := time.Now()
+			sort()
+			elapsed += time.Since(start)
+		}
+		b.Logf("N=%d: %d comparisons, %.1f ns/comparison",
+			b.N, compares, float64(elapsed)/float64(compares))
+	}
+
+	b.Run("NewCallback", func(b *testing.B) {
+		cmp := cgo.NewCallback(func(x, y unsafe.Pointer) int { return count(x, y) })
+		run(b, func() { C.sortInts(&a[0], n, C.uintptr_t(cmp)) })
+	})
+	b.Run("Handle", func(b *testing.B) {
+		compareHandleMu.Lock()
+		compareHandleFuncs[1] = count
+		compareHandleMu.Unlock()
+		run(b, func() { C.sortIntsHandle(&a[0], n, 1) })
+	})
+}
@@ -0,0 +1,49 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// +build !windows
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "_cgo_export.h"
+
+typedef int (*compare)(const void*, const void*);
+
+void
+sortInts(int *a, size_t n, uintptr_t cmp)
+{
+	qsort(a, n, sizeof a[0], (compare)cmp);
+}
+
+// The handle of the Go comparison function used by sortIntsHandle,
+// which C passes back to Go the way a callback's user data would be.
+static uintptr_t sortHandle;
+
+static int
+compareHandle(const void *x, const void *y)
+{
+	return goCompareHandle(sortHandle, (void*)x, (void*)y);
+}
+
+void
+sortIntsHandle(int *a, size_t n, uintptr_t h)
+{
+	sortHandle = h;
+	qsort(a, n, sizeof a[0], compareHandle);
+}
+
+typedef uintptr_t (*func6)(uintptr_t, uintptr_t, uintptr_t, uintptr_t, uintptr_t, uintptr_t);
+typedef uintptr_t (*func0)(void);
+
+uintptr_t
+callFunc6(uintptr_t f)
+{
+	return ((func6)f)(1, 2, 3, 4, 5, 6);
+}
+
+uintptr_t
+callFunc0(uintptr_t f)
+{
+	return ((func0)f)();
+}
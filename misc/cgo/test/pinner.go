@@ -0,0 +1,174 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+package cgotest
+
+// Zero-copy submission of Go buffers to an asynchronous C interface,
+// using runtime.Pinner.
+
+/*
+#include <stdlib.h>
+#include <string.h>
+
+// A stand-in for an asynchronous I/O interface: aioSubmit queues
+// requests and returns, and aioRun later fills in their buffers,
+// the way a kernel completion would.
+
+struct aioReq {
+	char *buf;
+	int len;
+	int done;
+};
+
+static struct aioReq *aioQueue;
+static int aioQueued;
+
+static void aioSubmit(struct aioReq *reqs, int n) {
+	aioQueue = reqs;
+	aioQueued = n;
+}
+
+static void aioRun(char c) {
+	int i;
+
+	for (i = 0; i < aioQueued; i++) {
+		memset(aioQueue[i].buf, c, aioQueue[i].len);
+		aioQueue[i].done = 1;
+	}
+	aioQueue = NULL;
+	aioQueued = 0;
+}
+
+// aioAllocReqs allocates n requests for C buffers of len bytes, for
+// a program that copies the data into Go memory afterward.
+static struct aioReq *aioAllocReqs(int n, int len) {
+	struct aioReq *reqs;
+	int i;
+
+	reqs = malloc(n * sizeof *reqs);
+	for (i = 0; i < n; i++) {
+		reqs[i].buf = malloc(len);
+		reqs[i].len = len;
+		reqs[i].done = 0;
+	}
+	return reqs;
+}
+
+static void aioFreeReqs(struct aioReq *reqs, int n) {
+	int i;
+
+	for (i = 0; i < n; i++) {
+		free(reqs[i].buf);
+	}
+	free(reqs);
+}
+*/
+import "C"
+
+import (
+	"fmt"
+	"runtime"
+	"strings"
+	"testing"
+	"unsafe"
+)
+
+// aioPinned reads into bufs through the C queue, passing pointers to
+// the Go buffers themselves. The requests also live in Go memory, and
+// C keeps pointers to both after aioSubmit returns.
+func aioPinned(bufs [][]byte, c byte, gc bool) []C.struct_aioReq {
+	var pinner runtime.Pinner
+	defer pinner.Unpin()
+
+	reqs := make([]C.struct_aioReq, len(bufs))
+	pinner.Pin(&reqs[0])
+	for i, buf := range bufs {
+		pinner.Pin(&buf[0])
+		reqs[i].buf = (*C.char)(unsafe.Pointer(&buf[0]))
+		reqs[i].len = C.int(len(buf))
+	}
+	C.aioSubmit(&reqs[0], C.int(len(reqs)))
+	if gc {
+		runtime.GC()
+	}
+	C.aioRun(C.char(c))
+	return reqs
+}
+
+// aioCopy does the same with C buffers, copying the data into bufs.
+func aioCopy(bufs [][]byte, c byte) {
+	n := C.int(len(bufs))
+	reqs := C.aioAllocReqs(n, C.int(len(bufs[0])))
+	C.aioSubmit(reqs, n)
+	C.aioRun(C.char(c))
+	creqs := (*[1 << 20]C.struct_aioReq)(unsafe.Pointer(reqs))[:len(bufs):len(bufs)]
+	for i, buf := range bufs {
+		copy(buf, (*[1 << 30]byte)(unsafe.Pointer(creqs[i].buf))[:len(buf):len(buf)])
+	}
+	C.aioFreeReqs(reqs, n)
+}
+
+func aioBufs(n, size int) [][]byte {
+	bufs := make([][]byte, n)
+	for i := range bufs {
+		bufs[i] = make([]byte, size)
+	}
+	return bufs
+}
+
+func testPinner(t *testing.T) {
+	bufs := aioBufs(8, 4096)
+	reqs := aioPinned(bufs, 'x', true)
+	for i, buf := range bufs {
+		if reqs[i].done == 0 {
+			t.Errorf("request %d not completed", i)
+		}
+		for j, b := range buf {
+			if b != 'x' {
+				t.Fatalf("buffer %d byte %d = %q, want 'x'", i, j, b)
+			}
+		}
+	}
+}
+
+// testPinnerRequired checks that the requests are rejected by the
+// cgo pointer checks if the buffers are not pinned.
+func testPinnerRequired(t *testing.T) {
+	buf := make([]byte, 16)
+	reqs := make([]C.struct_aioReq, 1)
+	reqs[0].buf = (*C.char)(unsafe.Pointer(&buf[0]))
+	reqs[0].len = C.int(len(buf))
+
+	defer func() {
+		r := recover()
+		if r == nil {
+			C.aioRun(0)
+			t.Fatal("unpinned Go pointer in Go memory passed to C without a panic")
+		}
+		if !strings.Contains(fmt.Sprint(r), "Go pointer to Go pointer") {
+			panic(r)
+		}
+	}()
+	C.aioSubmit(&reqs[0], 1)
+}
+
+// benchPinner compares submitting pinned Go buffers to copying
+// through C buffers.
+func benchPinner(b *testing.B) {
+	for _, size := range []int{512, 4096, 65536} {
+		bufs := aioBufs(8, size)
+		b.Run(fmt.Sprintf("pinned/%d", size), func(b *testing.B) {
+			b.SetBytes(int64(len(bufs) * size))
+			for i := 0; i < b.N; i++ {
+				aioPinned(bufs, byte(i), false)
+			}
+		})
+		b.Run(fmt.Sprintf("copy/%d", size), func(b *testing.B) {
+			b.SetBytes(int64(len(bufs) * size))
+			for i := 0; i < b.N; i++ {
+				aioCopy(bufs, byte(i))
+			}
+		})
+	}
+}
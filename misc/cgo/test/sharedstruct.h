@@ -0,0 +1,16 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#include <stddef.h>
+
+struct shared {
+	char c;
+	double d;
+	struct {
+		short s;
+		long l;
+	} inner;
+	struct shared *next;
+	int a[3];
+};
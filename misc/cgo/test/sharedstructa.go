@@ -0,0 +1,53 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// A tagged struct from a header included by several files of a
+// package converts to one Go type, laid out as in C.
+
+package cgotest
+
+/*
+#include "sharedstruct.h"
+
+static size_t sharedSize(void) { return sizeof(struct shared); }
+static size_t sharedOffset(int i) {
+	switch (i) {
+	case 0: return offsetof(struct shared, d);
+	case 1: return offsetof(struct shared, inner.l);
+	case 2: return offsetof(struct shared, next);
+	case 3: return offsetof(struct shared, a);
+	}
+	return 0;
+}
+*/
+import "C"
+
+import (
+	"testing"
+	"unsafe"
+)
+
+func testSharedStruct(t *testing.T) {
+	var s C.struct_shared = sharedStructMake()
+	if s.c != 'x' || s.d != 1.5 || s.inner.s != 2 || s.inner.l != 3 || s.next != nil || s.a[2] != 4 {
+		t.Errorf("struct from C = %+v", s)
+	}
+	if sharedStructSum(&s) != 'x'+1.5+2+3+4 {
+		t.Errorf("struct passed to C = %+v", s)
+	}
+
+	if got, want := unsafe.Sizeof(s), uintptr(C.sharedSize()); got != want {
+		t.Errorf("Sizeof(C.struct_shared) = %d, C sizeof = %d", got, want)
+	}
+	for i, got := range []uintptr{
+		unsafe.Offsetof(s.d),
+		unsafe.Offsetof(s.inner) + unsafe.Offsetof(s.inner.l),
+		unsafe.Offsetof(s.next),
+		unsafe.Offsetof(s.a),
+	} {
+		if want := uintptr(C.sharedOffset(C.int(i))); got != want {
+			t.Errorf("field %d at offset %d, C offset %d", i, got, want)
+		}
+	}
+}
@@ -0,0 +1,27 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+package cgotest
+
+/*
+#include "sharedstruct.h"
+
+static struct shared makeShared(void) {
+	struct shared s = {'x', 1.5, {2, 3}, NULL, {0, 0, 4}};
+	return s;
+}
+
+static double sumShared(struct shared *s) {
+	return s->c + s->d + s->inner.s + s->inner.l + s->a[0] + s->a[1] + s->a[2];
+}
+*/
+import "C"
+
+func sharedStructMake() C.struct_shared {
+	return C.makeShared()
+}
+
+func sharedStructSum(s *C.struct_shared) float64 {
+	return float64(C.sumShared(s))
+}
@@ -776,3 +776,177 @@ func TestCachedInstall(t *testing.T) {
 		t.Errorf("p.h not installed in second run: %v", err)
 	}
 }
+
+// buildLazyInit builds testp7 from main7.c and libgo7. The caller
+// must remove the files it creates by calling the returned function.
+func buildLazyInit(tb testing.TB) (cleanup func()) {
+	cleanup = func() {
+		os.Remove("testp7" + exeSuffix)
+		os.Remove("libgo7.a")
+		os.Remove("libgo7.h")
+	}
+
+	cmd := exec.Command("go", "build", "-buildmode=c-archive", "-o", "libgo7.a", "libgo7")
+	cmd.Env = gopathEnv
+	if out, err := cmd.CombinedOutput(); err != nil {
+		cleanup()
+		tb.Logf("%s", out)
+		tb.Fatal(err)
+	}
+
+	ccArgs := append(cc, "-o", "testp7"+exeSuffix, "main7.c", "libgo7.a")
+	if out, err := exec.Command(ccArgs[0], ccArgs[1:]...).CombinedOutput(); err != nil {
+		cleanup()
+		tb.Logf("%s", out)
+		tb.Fatal(err)
+	}
+	return cleanup
+}
+
+func TestLazyInit(t *testing.T) {
+	switch GOOS {
+	case "windows", "plan9":
+		t.Skipf("skipping lazy init test on %s", GOOS)
+	}
+	if runtime.Compiler == "gccgo" {
+		t.Skip("skipping lazy init test with gccgo")
+	}
+
+	t.Parallel()
+
+	defer buildLazyInit(t)()
+
+	for _, mode := range []string{"lazy", "prewarm"} {
+		argv := append(cmdToRun("./testp7"), mode)
+		cmd := exec.Command(argv[0], argv[1:]...)
+		cmd.Env = append(os.Environ(), "GODEBUG=cgolazyinit=1")
+		if out, err := cmd.CombinedOutput(); err != nil {
+			t.Logf("%s", out)
+			t.Errorf("%s: %v", mode, err)
+		}
+	}
+}
+
+// BenchmarkStartup reports how long a C program that spends about 20ms
+// of its own takes to run with a Go library whose initialization also
+// takes a while, for each way of starting the Go runtime.
+func BenchmarkStartup(b *testing.B) {
+	switch GOOS {
+	case "windows", "plan9":
+		b.Skipf("skipping startup benchmark on %s", GOOS)
+	}
+	if runtime.Compiler == "gccgo" {
+		b.Skip("skipping startup benchmark with gccgo")
+	}
+
+	defer buildLazyInit(b)()
+
+	for _, bm := range []struct {
+		name string
+		lazy bool
+		mode string
+	}{
+		{"Eager/NoCall", false, "nocall"},
+		{"Eager/Call", false, "call"},
+		{"Lazy/NoCall", true, "nocall"},
+		{"Lazy/Call", true, "call"},
+		{"Lazy/Prewarm", true, "prewarm"},
+	} {
+		b.Run(bm.name, func(b *testing.B) {
+			argv := append(cmdToRun("./testp7"), "work", bm.mode)
+			env := os.Environ()
+			if bm.lazy {
+				env = append(env, "GODEBUG=cgolazyinit=1")
+			}
+			for i := 0; i < b.N; i++ {
+				cmd := exec.Command(argv[0], argv[1:]...)
+				cmd.Env = env
+				if out, err := cmd.CombinedOutput(); err != nil {
+					b.Logf("%s", out)
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
+
+// buildSignalRate builds testp8 from main8.c and libgo8. The caller
+// must remove the files it creates by calling the returned function.
+func buildSignalRate(tb testing.TB) (cleanup func()) {
+	cleanup = func() {
+		os.Remove("testp8" + exeSuffix)
+		os.Remove("libgo8.a")
+		os.Remove("libgo8.h")
+	}
+
+	cmd := exec.Command("go", "build", "-buildmode=c-archive", "-o", "libgo8.a", "libgo8")
+	cmd.Env = gopathEnv
+	if out, err := cmd.CombinedOutput(); err != nil {
+		cleanup()
+		tb.Logf("%s", out)
+		tb.Fatal(err)
+	}
+
+	ccArgs := append(cc, "-o", "testp8"+exeSuffix, "main8.c", "libgo8.a")
+	if out, err := exec.Command(ccArgs[0], ccArgs[1:]...).CombinedOutput(); err != nil {
+		cleanup()
+		tb.Logf("%s", out)
+		tb.Fatal(err)
+	}
+	return cleanup
+}
+
+func TestOsSignalForward(t *testing.T) {
+	switch GOOS {
+	case "windows", "plan9":
+		t.Skipf("skipping signal test on %s", GOOS)
+	}
+	if runtime.Compiler == "gccgo" {
+		t.Skip("skipping signal forward test with gccgo")
+	}
+
+	t.Parallel()
+
+	defer buildSignalRate(t)()
+
+	for _, mode := range []string{"host", "notify", "forward"} {
+		argv := append(cmdToRun("./testp8"), mode, "100")
+		if out, err := exec.Command(argv[0], argv[1:]...).CombinedOutput(); err != nil {
+			t.Logf("%s", out)
+			t.Errorf("%s: %v", mode, err)
+		}
+	}
+}
+
+// BenchmarkSignalRate reports how fast a C thread can raise SIGIO and
+// have it handled, by a C handler alone, by the Go handler after
+// signal.Notify, and by the C handler after signal.Forward. Each
+// operation is a run of testp8 raising 100000 signals; the time per
+// signal is logged.
+func BenchmarkSignalRate(b *testing.B) {
+	switch GOOS {
+	case "windows", "plan9":
+		b.Skipf("skipping signal benchmark on %s", GOOS)
+	}
+	if runtime.Compiler == "gccgo" {
+		b.Skip("skipping signal benchmark with gccgo")
+	}
+
+	defer buildSignalRate(b)()
+
+	for _, mode := range []string{"host", "notify", "forward"} {
+		b.Run(mode, func(b *testing.B) {
+			argv := append(cmdToRun("./testp8"), mode, "100000")
+			for i := 0; i < b.N; i++ {
+				out, err := exec.Command(argv[0], argv[1:]...).CombinedOutput()
+				if err != nil {
+					b.Logf("%s", out)
+					b.Fatal(err)
+				}
+				if i == 0 {
+					b.Logf("%s", bytes.TrimSpace(out))
+				}
+			}
+		})
+	}
+}
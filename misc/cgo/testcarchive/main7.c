@@ -0,0 +1,93 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// Test starting the Go runtime lazily, with GODEBUG=cgolazyinit=1,
+// and measure how long a program using a Go library takes to run.
+//
+// testp7 lazy: the runtime must start on the first call into Go.
+// testp7 prewarm: the runtime must start on GoStartRuntime_libgo7.
+// testp7 work nocall|call|prewarm: do some work in C, and call into
+// Go after it, or not at all; for benchmarks.
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "libgo7.h"
+
+extern int Libgo7InitRan(void);
+
+// work spins for about 20ms, standing in for the rest of the program.
+static void work(void) {
+	struct timespec start, now;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	do {
+		clock_gettime(CLOCK_MONOTONIC, &now);
+	} while ((now.tv_sec - start.tv_sec) * 1000000000LL + (now.tv_nsec - start.tv_nsec) < 20000000LL);
+}
+
+static int ping(void) {
+	GoInt32 res;
+
+	res = Ping();
+	if (res != 64) {
+		fprintf(stderr, "ERROR: Ping()=%d, want 64\n", (int)res);
+		return 2;
+	}
+	return 0;
+}
+
+int main(int argc, char** argv) {
+	int i;
+
+	if (argc == 2 && strcmp(argv[1], "lazy") == 0) {
+		usleep(100000);
+		if (Libgo7InitRan()) {
+			fprintf(stderr, "ERROR: init ran before the first call into Go\n");
+			return 2;
+		}
+		if (ping() != 0) {
+			return 2;
+		}
+		fprintf(stderr, "PASS\n");
+		return 0;
+	}
+
+	if (argc == 2 && strcmp(argv[1], "prewarm") == 0) {
+		usleep(100000);
+		if (Libgo7InitRan()) {
+			fprintf(stderr, "ERROR: init ran before GoStartRuntime_libgo7\n");
+			return 2;
+		}
+		GoStartRuntime_libgo7();
+		for (i = 0; !Libgo7InitRan(); i++) {
+			if (i >= 1000) {
+				fprintf(stderr, "ERROR: init did not run after GoStartRuntime_libgo7\n");
+				return 2;
+			}
+			usleep(10000);
+		}
+		if (ping() != 0) {
+			return 2;
+		}
+		fprintf(stderr, "PASS\n");
+		return 0;
+	}
+
+	if (argc == 3 && strcmp(argv[1], "work") == 0) {
+		if (strcmp(argv[2], "prewarm") == 0) {
+			GoStartRuntime_libgo7();
+		}
+		work();
+		if (strcmp(argv[2], "nocall") != 0) {
+			return ping();
+		}
+		return 0;
+	}
+
+	fprintf(stderr, "usage: testp7 lazy | prewarm | work nocall|call|prewarm\n");
+	return 2;
+}
@@ -0,0 +1,92 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// Test a C program that handles SIGIO itself, at a high rate, with a
+// Go library that may ask for SIGIO too, and measure the rate.
+//
+// testp8 MODE N installs a SIGIO handler before the Go code starts, as
+// main4.c does, and then raises SIGIO N times on the main thread,
+// which is not a Go thread. MODE is
+//	host: Go does not touch SIGIO, so the C handler gets them all;
+//	notify: Go calls signal.Notify, so the Go handler gets them all;
+//	forward: Go calls signal.Notify and then signal.Forward, so the C
+//	handler gets them all again.
+// It prints the number of signals the C handler saw and the time per
+// signal.
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "libgo8.h"
+
+static void die(const char* msg) {
+	perror(msg);
+	exit(EXIT_FAILURE);
+}
+
+static volatile sig_atomic_t sigioCount;
+
+static void ioHandler(int signo, siginfo_t* info, void* ctxt) {
+	sigioCount++;
+}
+
+static void init(void) __attribute__ ((constructor (200)));
+
+static void init() {
+	struct sigaction sa;
+
+	memset(&sa, 0, sizeof sa);
+	sa.sa_sigaction = ioHandler;
+	if (sigemptyset(&sa.sa_mask) < 0) {
+		die("sigemptyset");
+	}
+	sa.sa_flags = SA_SIGINFO | SA_ONSTACK;
+	if (sigaction(SIGIO, &sa, NULL) < 0) {
+		die("sigaction");
+	}
+}
+
+int main(int argc, char** argv) {
+	int i, n, want;
+	struct timespec start, end;
+	double ns;
+
+	if (argc != 3) {
+		fprintf(stderr, "usage: testp8 host|notify|forward N\n");
+		exit(EXIT_FAILURE);
+	}
+	n = atoi(argv[2]);
+	if (strcmp(argv[1], "host") == 0) {
+		want = n;
+	} else if (strcmp(argv[1], "notify") == 0) {
+		GoCatchSIGIO();
+		want = 0;
+	} else if (strcmp(argv[1], "forward") == 0) {
+		GoCatchSIGIO();
+		GoForwardSIGIO();
+		want = n;
+	} else {
+		fprintf(stderr, "unknown mode %s\n", argv[1]);
+		exit(EXIT_FAILURE);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < n; i++) {
+		if (raise(SIGIO) != 0) {
+			die("raise");
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	ns = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+	printf("%d signals, %d handled by C, %.1f ns/signal\n", n, (int)sigioCount, ns / n);
+	if (sigioCount != want) {
+		fprintf(stderr, "C handler saw %d signals, want %d\n", (int)sigioCount, want);
+		exit(EXIT_FAILURE);
+	}
+	return 0;
+}
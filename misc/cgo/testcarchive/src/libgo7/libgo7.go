@@ -0,0 +1,26 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+package main
+
+// extern void libgo7MarkInit(void);
+import "C"
+
+// table is built at init time, to emulate a package whose
+// initialization takes a while.
+var table = make(map[int]int)
+
+func init() {
+	for i := 0; i < 1<<17; i++ {
+		table[i] = i * i
+	}
+	C.libgo7MarkInit()
+}
+
+func main() {}
+
+//export Ping
+func Ping() int32 {
+	return int32(len(table) >> 11)
+}
@@ -0,0 +1,33 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+package main
+
+import "C"
+
+import (
+	"os"
+	"os/signal"
+	"syscall"
+)
+
+// Catch SIGIO, as a Go package in a library might.
+//export GoCatchSIGIO
+func GoCatchSIGIO() {
+	c := make(chan os.Signal, 1)
+	signal.Notify(c, syscall.SIGIO)
+	go func() {
+		for range c {
+		}
+	}()
+}
+
+// Leave SIGIO to the C handler.
+//export GoForwardSIGIO
+func GoForwardSIGIO() {
+	signal.Forward(syscall.SIGIO)
+}
+
+func main() {
+}
@@ -507,6 +507,102 @@ func TestPIE(t *testing.T) {
 	}
 }
 
+// TestTLSModel checks that the runtime reaches its thread-local
+// storage in a shared library with the initial-exec model, which
+// needs no calls to __tls_get_addr, and that the library is marked
+// accordingly.
+func TestTLSModel(t *testing.T) {
+	t.Parallel()
+
+	if GOOS != "linux" {
+		t.Skipf("skipping on %s", GOOS)
+	}
+
+	createHeadersOnce(t)
+
+	f, err := elf.Open(libgoname)
+	if err != nil {
+		t.Fatalf("elf.Open failed: %v", err)
+	}
+	defer f.Close()
+
+	syms, err := f.ImportedSymbols()
+	if err != nil {
+		t.Fatal(err)
+	}
+	for _, s := range syms {
+		if s.Name == "__tls_get_addr" {
+			t.Errorf("%s imports %s", libgoname, s.Name)
+		}
+	}
+
+	ds := f.SectionByType(elf.SHT_DYNAMIC)
+	if ds == nil {
+		t.Fatalf("no SHT_DYNAMIC section")
+	}
+	d, err := ds.Data()
+	if err != nil {
+		t.Fatalf("can't read SHT_DYNAMIC contents: %v", err)
+	}
+	var flags uint64
+	for len(d) > 0 {
+		var tag elf.DynTag
+		var val uint64
+		switch f.Class {
+		case elf.ELFCLASS32:
+			tag = elf.DynTag(f.ByteOrder.Uint32(d[:4]))
+			val = uint64(f.ByteOrder.Uint32(d[4:8]))
+			d = d[8:]
+		case elf.ELFCLASS64:
+			tag = elf.DynTag(f.ByteOrder.Uint64(d[:8]))
+			val = f.ByteOrder.Uint64(d[8:16])
+			d = d[16:]
+		}
+		if tag == elf.DT_FLAGS {
+			flags = val
+		}
+	}
+	if flags&uint64(elf.DF_STATIC_TLS) == 0 {
+		t.Errorf("%s does not have the DF_STATIC_TLS flag", libgoname)
+	}
+}
+
+// BenchmarkTLS compares calls into and within Go code in libgo6 built
+// as a shared library, which reaches the runtime's thread-local storage
+// through the initial-exec model, and as an archive linked into the
+// executable, where the linker turns that into the local-exec model.
+func BenchmarkTLS(b *testing.B) {
+	if GOOS != "linux" {
+		b.Skipf("skipping on %s", GOOS)
+	}
+
+	defer func() {
+		for _, f := range []string{"libgo6.so", "libgo6.a", "libgo6.h", "testp7shared", "testp7archive"} {
+			os.Remove(f)
+		}
+	}()
+	runBench := func(b *testing.B, args ...string) {
+		cmd := exec.Command(args[0], args[1:]...)
+		cmd.Env = append(gopathEnv, "LD_LIBRARY_PATH=.")
+		if out, err := cmd.CombinedOutput(); err != nil {
+			b.Fatalf("command failed: %v\n%v\n%s\n", args, err, out)
+		}
+	}
+	runBench(b, "go", "build", "-buildmode=c-shared", "-o", "libgo6.so", "libgo6")
+	runBench(b, "go", "build", "-buildmode=c-archive", "-o", "libgo6.a", "libgo6")
+	cc := append([]string(nil), cc...)
+	runBench(b, append(cc, "-o", "testp7shared", "main7.c", "libgo6.so")...)
+	runBench(b, append(cc, "-o", "testp7archive", "main7.c", "libgo6.a", "-lpthread")...)
+
+	for _, mode := range []string{"cgo", "go"} {
+		for _, bin := range []string{"shared", "archive"} {
+			b.Run(mode+"/"+bin, func(b *testing.B) {
+				runBench(b, "./testp7"+bin, mode, fmt.Sprint(b.N))
+			})
+		}
+	}
+}
+
 // Test that installing a second time recreates the header files.
 func TestCachedInstall(t *testing.T) {
 	tmpdir, err := ioutil.TempDir("", "cshared")
@@ -588,6 +684,79 @@ func TestCachedInstall(t *testing.T) {
 	}
 }
 
+// TestMultipleLibraries loads several copies of a Go shared library
+// into one process. Each has its own Go runtime; the test logs the
+// resident set size and number of threads after loading each one.
+func TestMultipleLibraries(t *testing.T) {
+	if GOOS != "linux" {
+		t.Skipf("skipping on %s; needs /proc/self/status", GOOS)
+	}
+	t.Parallel()
+
+	createHeadersOnce(t)
+
+	cmd := "testp6"
+	bin := cmdToRun(cmd)
+	runCC(t, "-o", cmd, "main6.c", "-ldl")
+	defer os.Remove(bin)
+
+	dir, err := ioutil.TempDir("", "testcshared")
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer os.RemoveAll(dir)
+
+	// Distinct file names, so that the dynamic linker loads a
+	// separate copy of the library each time.
+	args := []string{bin}
+	for i := 0; i < 5; i++ {
+		lib := filepath.Join(dir, fmt.Sprintf("libgo%d.%s", i, libSuffix))
+		copyFile(t, lib, libgoname)
+		args = append(args, lib)
+	}
+
+	out := runExe(t, nil, args...)
+	if !strings.HasSuffix(strings.TrimSpace(out), "PASS") {
+		t.Error(out)
+	}
+	t.Logf("%s", out)
+}
+
+// TestLazyInitMultipleLibraries links two Go shared libraries into one
+// program with GODEBUG=cgolazyinit=1, and checks that each library's
+// GoStartRuntime_ function starts only that library's runtime.
+func TestLazyInitMultipleLibraries(t *testing.T) {
+	switch GOOS {
+	case "windows", "android":
+		t.Skipf("skipping on %s", GOOS)
+	}
+	t.Parallel()
+
+	cmd := "testp8"
+	bin := cmdToRun(cmd)
+	libs := []string{"libgo7", "libgo8"}
+	for _, lib := range libs {
+		libname := lib + "." + libSuffix
+		run(t,
+			gopathEnv,
+			"go", "build",
+			"-buildmode=c-shared",
+			"-installsuffix", "testcshared",
+			"-o", libname, lib,
+		)
+		defer os.Remove(libname)
+		defer os.Remove(lib + ".h")
+	}
+
+	runCC(t, "-I", ".", "-o", cmd, "main8.c", "libgo7."+libSuffix, "libgo8."+libSuffix)
+	defer os.Remove(bin)
+
+	out := runExe(t, append(gopathEnv, "LD_LIBRARY_PATH=.", "GODEBUG=cgolazyinit=1"), bin)
+	if strings.TrimSpace(out) != "PASS" {
+		t.Error(out)
+	}
+}
+
 // copyFile copies src to dst.
 func copyFile(t *testing.T, dst, src string) {
 	t.Helper()
@@ -0,0 +1,60 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// Test that several Go shared libraries can be loaded into one
+// process, and report what each of them costs. Each library has its
+// own Go runtime, with its own heap and threads.
+// Linux only: the numbers come from /proc/self/status.
+
+#include <dlfcn.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// status prints the resident set size and the number of threads.
+static void status(int n) {
+	FILE* f;
+	char line[256];
+	long rss, threads;
+
+	rss = threads = -1;
+	f = fopen("/proc/self/status", "r");
+	if (f == NULL) {
+		perror("/proc/self/status");
+		return;
+	}
+	while (fgets(line, sizeof line, f) != NULL) {
+		sscanf(line, "VmRSS: %ld", &rss);
+		sscanf(line, "Threads: %ld", &threads);
+	}
+	fclose(f);
+	printf("libraries=%d rss=%ldkB threads=%ld\n", n, rss, threads);
+}
+
+int main(int argc, char** argv) {
+	int i;
+	void* handle;
+	int8_t (*fn)(void);
+
+	status(0);
+	for (i = 1; i < argc; i++) {
+		handle = dlopen(argv[i], RTLD_NOW | RTLD_LOCAL);
+		if (handle == NULL) {
+			fprintf(stderr, "ERROR: failed to open %s: %s\n", argv[i], dlerror());
+			return 2;
+		}
+		fn = (int8_t (*)(void))dlsym(handle, "DidInitRun");
+		if (fn == NULL) {
+			fprintf(stderr, "ERROR: missing DidInitRun in %s: %s\n", argv[i], dlerror());
+			return 2;
+		}
+		if (!fn()) {
+			fprintf(stderr, "ERROR: DidInitRun in %s returned false\n", argv[i]);
+			return 2;
+		}
+		status(i);
+	}
+	printf("PASS\n");
+	return 0;
+}
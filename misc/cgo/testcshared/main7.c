@@ -0,0 +1,38 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// Make calls into Go, for BenchmarkTLS. It is linked either with
+// libgo6 as a shared library or with libgo6 as an archive, which
+// reach the Go runtime's thread-local storage in different ways.
+//
+// testp7 cgo N: call an exported Go function N times.
+// testp7 go N: make N calls between Go functions.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libgo6.h"
+
+int main(int argc, char** argv) {
+	long n, i;
+
+	if (argc != 3) {
+		fprintf(stderr, "usage: testp7 cgo|go N\n");
+		return 2;
+	}
+	n = atol(argv[2]);
+	if (strcmp(argv[1], "cgo") == 0) {
+		for (i = 0; i < n; i++) {
+			Noop();
+		}
+	} else if (strcmp(argv[1], "go") == 0) {
+		Calls(n);
+	} else {
+		fprintf(stderr, "unknown mode %s\n", argv[1]);
+		return 2;
+	}
+	printf("PASS\n");
+	return 0;
+}
@@ -0,0 +1,66 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// Test that two Go shared libraries linked into one program, and
+// loaded with GODEBUG=cgolazyinit=1, each have their own function to
+// start the Go runtime, and that it starts only that library's.
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include "libgo7.h"
+#include "libgo8.h"
+
+extern int Libgo7InitRan(void);
+extern int Libgo8InitRan(void);
+
+// waitInit waits for up to 10 seconds for initRan to report true.
+static int waitInit(int (*initRan)(void)) {
+	int i;
+
+	for (i = 0; !initRan(); i++) {
+		if (i >= 1000) {
+			return 0;
+		}
+		usleep(10000);
+	}
+	return 1;
+}
+
+int main(void) {
+	usleep(100000);
+	if (Libgo7InitRan() || Libgo8InitRan()) {
+		fprintf(stderr, "ERROR: init ran before the runtime was started\n");
+		return 2;
+	}
+
+	GoStartRuntime_libgo7();
+	if (!waitInit(Libgo7InitRan)) {
+		fprintf(stderr, "ERROR: libgo7 init did not run after GoStartRuntime_libgo7\n");
+		return 2;
+	}
+	usleep(100000);
+	if (Libgo8InitRan()) {
+		fprintf(stderr, "ERROR: libgo8 init ran after GoStartRuntime_libgo7\n");
+		return 2;
+	}
+
+	GoStartRuntime_libgo8();
+	if (!waitInit(Libgo8InitRan)) {
+		fprintf(stderr, "ERROR: libgo8 init did not run after GoStartRuntime_libgo8\n");
+		return 2;
+	}
+
+	if (Ping7() != 7) {
+		fprintf(stderr, "ERROR: Ping7()=%d, want 7\n", (int)Ping7());
+		return 2;
+	}
+	if (Ping8() != 8) {
+		fprintf(stderr, "ERROR: Ping8()=%d, want 8\n", (int)Ping8());
+		return 2;
+	}
+
+	printf("PASS\n");
+	return 0;
+}
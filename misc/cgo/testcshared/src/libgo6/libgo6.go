@@ -0,0 +1,33 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+package main
+
+import "C"
+
+func main() {}
+
+//go:noinline
+func leaf(i int) int {
+	return i + 1
+}
+
+// nonleaf has a stack check in its prologue, which loads g from
+// thread-local storage.
+//go:noinline
+func nonleaf(i int) int {
+	return leaf(i) * 2
+}
+
+//export Noop
+func Noop() {}
+
+//export Calls
+func Calls(n int) int {
+	s := 0
+	for i := 0; i < n; i++ {
+		s += nonleaf(i)
+	}
+	return s
+}
@@ -0,0 +1,17 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+static int initRan;
+
+// libgo7MarkInit is called by the package init function.
+void
+libgo7MarkInit(void) {
+	__atomic_store_n(&initRan, 1, __ATOMIC_RELEASE);
+}
+
+// Libgo7InitRan reports whether the package init function has run.
+int
+Libgo7InitRan(void) {
+	return __atomic_load_n(&initRan, __ATOMIC_ACQUIRE);
+}
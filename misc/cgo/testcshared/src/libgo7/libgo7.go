@@ -0,0 +1,25 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+package main
+
+// extern void libgo7MarkInit(void);
+import "C"
+
+var initRan bool
+
+func init() {
+	initRan = true
+	C.libgo7MarkInit()
+}
+
+func main() {}
+
+//export Ping7
+func Ping7() int32 {
+	if !initRan {
+		return 0
+	}
+	return 7
+}
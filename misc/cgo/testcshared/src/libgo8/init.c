@@ -0,0 +1,17 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+static int initRan;
+
+// libgo8MarkInit is called by the package init function.
+void
+libgo8MarkInit(void) {
+	__atomic_store_n(&initRan, 1, __ATOMIC_RELEASE);
+}
+
+// Libgo8InitRan reports whether the package init function has run.
+int
+Libgo8InitRan(void) {
+	return __atomic_load_n(&initRan, __ATOMIC_ACQUIRE);
+}
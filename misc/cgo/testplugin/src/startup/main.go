@@ -0,0 +1,64 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// Startup opens the plugins named on the command line concurrently,
+// checks a symbol from each, and reports how long that took.
+package main
+
+import (
+	"fmt"
+	"os"
+	"plugin"
+	"sync"
+	"time"
+)
+
+func main() {
+	paths := os.Args[1:]
+	start := time.Now()
+	errs := make([]error, len(paths))
+	var wg sync.WaitGroup
+	for i, path := range paths {
+		wg.Add(1)
+		go func(i int, path string) {
+			defer wg.Done()
+			errs[i] = check(path)
+		}(i, path)
+	}
+	wg.Wait()
+	elapsed := time.Since(start)
+
+	for i, err := range errs {
+		if err != nil {
+			fmt.Fprintf(os.Stderr, "startup: %s: %v\n", paths[i], err)
+			os.Exit(1)
+		}
+	}
+	fmt.Printf("startup: opened %d plugins in %v\n", len(paths), elapsed)
+}
+
+func check(path string) error {
+	p, err := plugin.Open(path)
+	if err != nil {
+		return err
+	}
+	f, err := p.Lookup("F1")
+	if err != nil {
+		return err
+	}
+	v, err := p.Lookup("V2")
+	if err != nil {
+		return err
+	}
+	if got := f.(func() int)(); got != 1 {
+		return fmt.Errorf("F1() = %d, want 1", got)
+	}
+	if got := *v.(*int); got != 2 {
+		return fmt.Errorf("V2 = %d, want 2", got)
+	}
+	if _, err := p.Lookup("Missing"); err == nil {
+		return fmt.Errorf("Lookup(Missing) succeeded")
+	}
+	return nil
+}
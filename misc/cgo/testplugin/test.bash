@@ -15,8 +15,8 @@ goos=$(go env GOOS)
 goarch=$(go env GOARCH)
 
 function cleanup() {
-	rm -f plugin*.so unnamed*.so iface*.so life.so issue*
-	rm -rf host pkg sub iface
+	rm -f plugin*.so unnamed*.so iface*.so life.so issue* startup*.so
+	rm -rf host pkg sub iface startup startup_plugin
 }
 trap cleanup EXIT
 
@@ -99,3 +99,20 @@ for i in `seq 1 20`;
 do
   ./issue25756 > /dev/null
 done
+
+# Plugin startup benchmark: open many plugins, each exporting many
+# symbols, and report the time taken. The plugins share one source
+# file and are told apart by their plugin path.
+mkdir startup_plugin
+{
+	echo "package main"
+	for i in `seq 1 500`; do
+		echo "func F$i() int { return $i }"
+		echo "var V$i = $i"
+	done
+} > startup_plugin/plugin.go
+for i in `seq 1 20`; do
+	GOPATH=$(pwd) go build -gcflags "$GO_GCFLAGS" -buildmode=plugin -ldflags="-pluginpath=startup$i" -o startup$i.so startup_plugin/plugin.go
+done
+GOPATH=$(pwd) go build -gcflags "$GO_GCFLAGS" -o startup src/startup/main.go
+./startup startup*.so
@@ -0,0 +1,92 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// Package testregex runs the AT&T POSIX regular expression tests in
+// src/regexp/testdata, the ones testregex.c drives, against both
+// package regexp and the C library's regcomp and regexec, comparing
+// their results and their speed.
+package testregex
+
+/*
+#include <regex.h>
+#include <stdlib.h>
+*/
+import "C"
+
+import (
+	"errors"
+	"strings"
+	"unsafe"
+)
+
+// A posixRegexp is a regular expression compiled by regcomp.
+type posixRegexp struct {
+	re    *C.regex_t
+	match []C.regmatch_t
+	loc   []int
+}
+
+// compilePOSIX compiles pattern as a POSIX extended regular expression.
+func compilePOSIX(pattern string, icase bool) (*posixRegexp, error) {
+	if strings.IndexByte(pattern, 0) >= 0 {
+		return nil, errors.New("pattern contains NUL")
+	}
+	cflags := C.int(C.REG_EXTENDED)
+	if icase {
+		cflags |= C.REG_ICASE
+	}
+	cpat := C.CString(pattern)
+	defer C.free(unsafe.Pointer(cpat))
+	re := (*C.regex_t)(C.malloc(C.sizeof_regex_t))
+	if rc := C.regcomp(re, cpat, cflags); rc != 0 {
+		var buf [256]C.char
+		C.regerror(rc, re, &buf[0], C.size_t(len(buf)))
+		C.free(unsafe.Pointer(re))
+		return nil, errors.New(C.GoString(&buf[0]))
+	}
+	n := int(re.re_nsub) + 1
+	return &posixRegexp{
+		re:    re,
+		match: make([]C.regmatch_t, n),
+		loc:   make([]int, 2*n),
+	}, nil
+}
+
+// free releases the memory regcomp allocated.
+func (p *posixRegexp) free() {
+	C.regfree(p.re)
+	C.free(unsafe.Pointer(p.re))
+}
+
+// A cText is a NUL-terminated copy of a subject string in C memory,
+// so that benchmarks do not measure the conversion.
+type cText struct {
+	p *C.char
+}
+
+func newCText(s string) (*cText, error) {
+	if strings.IndexByte(s, 0) >= 0 {
+		return nil, errors.New("text contains NUL")
+	}
+	return &cText{C.CString(s)}, nil
+}
+
+func (t *cText) free() {
+	C.free(unsafe.Pointer(t.p))
+}
+
+// exec runs regexec on t and returns the offsets of the match and its
+// subexpressions, with -1 for subexpressions that did not participate,
+// or nil if there is no match. The result is overwritten by the next
+// call.
+func (p *posixRegexp) exec(t *cText) []int {
+	if C.regexec(p.re, t.p, C.size_t(len(p.match)), &p.match[0], 0) != 0 {
+		return nil
+	}
+	for i, m := range p.match {
+		p.loc[2*i] = int(m.rm_so)
+		p.loc[2*i+1] = int(m.rm_eo)
+	}
+	return p.loc
+}
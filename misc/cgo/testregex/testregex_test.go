@@ -0,0 +1,283 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+package testregex
+
+import (
+	"bufio"
+	"fmt"
+	"io"
+	"os"
+	"path/filepath"
+	"regexp"
+	"regexp/syntax"
+	"runtime"
+	"strconv"
+	"strings"
+	"testing"
+)
+
+var datFiles = []string{"basic.dat", "nullsubexpr.dat", "repetition.dat"}
+
+// A testCase is one ERE test from a .dat file. See the description of
+// the format in src/regexp/exec_test.go.
+type testCase struct {
+	file    string
+	line    int
+	pattern string
+	icase   bool
+	text    string
+	compile bool  // the pattern should compile
+	pos     []int // expected match and subexpression offsets, or nil for no match
+}
+
+func (c *testCase) String() string {
+	return fmt.Sprintf("%s:%d", c.file, c.line)
+}
+
+var notab = regexp.MustCompilePOSIX(`[^\t]+`)
+
+func loadCases(tb testing.TB) []*testCase {
+	var cases []*testCase
+	for _, name := range datFiles {
+		file := filepath.Join(runtime.GOROOT(), "src", "regexp", "testdata", name)
+		f, err := os.Open(file)
+		if err != nil {
+			tb.Fatal(err)
+		}
+		b := bufio.NewReader(f)
+		last := ""
+		for lineno := 1; ; lineno++ {
+			line, err := b.ReadString('\n')
+			if err != nil {
+				if err != io.EOF {
+					tb.Fatal(err)
+				}
+				break
+			}
+			if c := parseCase(line, &last); c != nil {
+				c.file, c.line = name, lineno
+				cases = append(cases, c)
+			}
+		}
+		f.Close()
+	}
+	return cases
+}
+
+// parseCase parses a line of a .dat file and returns the ERE test it
+// specifies, or nil. last holds the previous pattern, for SAME.
+func parseCase(line string, last *string) *testCase {
+	if line[0] == '#' || line[0] == '\n' {
+		return nil
+	}
+	field := notab.FindAllString(strings.TrimSuffix(line, "\n"), -1)
+	if len(field) < 4 {
+		return nil
+	}
+	for i, f := range field {
+		if f == "NULL" {
+			field[i] = ""
+		}
+		if f == "NIL" {
+			return nil
+		}
+	}
+	flag := strings.TrimLeft(field[0], "?&|;{}")
+	if strings.HasPrefix(flag, ":") {
+		i := strings.Index(flag[1:], ":")
+		if i < 0 {
+			return nil
+		}
+		flag = flag[1+i+1:]
+	}
+	if !strings.Contains(flag, "E") {
+		return nil
+	}
+	if strings.Contains(flag, "$") {
+		var err1, err2 error
+		field[1], err1 = strconv.Unquote(`"` + field[1] + `"`)
+		field[2], err2 = strconv.Unquote(`"` + field[2] + `"`)
+		if err1 != nil || err2 != nil {
+			return nil
+		}
+	}
+	if field[1] == "SAME" {
+		field[1] = *last
+	}
+	*last = field[1]
+	c := &testCase{
+		pattern: field[1],
+		icase:   strings.Contains(flag, "i"),
+		text:    field[2],
+		compile: true,
+	}
+	switch res := field[3]; {
+	case res == "":
+		// A match, with no offsets given.
+		c.pos = []int{}
+	case res == "NOMATCH":
+	case 'A' <= res[0] && res[0] <= 'Z':
+		c.compile = false
+	default:
+		for _, m := range strings.SplitAfter(res, ")") {
+			if m == "" {
+				continue
+			}
+			i := strings.Index(m, ",")
+			if i < 0 || m[0] != '(' {
+				return nil
+			}
+			for _, s := range []string{m[1:i], m[i+1 : len(m)-1]} {
+				v := -1
+				if s != "?" {
+					var err error
+					if v, err = strconv.Atoi(s); err != nil {
+						return nil
+					}
+				}
+				c.pos = append(c.pos, v)
+			}
+		}
+	}
+	return c
+}
+
+// compileGo compiles c's pattern with package regexp, using the same
+// syntax flags as exec_test.go. Those are not all available through
+// the regexp API, so the pattern is parsed first and the result
+// compiled in Perl syntax with leftmost-longest matching.
+func compileGo(c *testCase) (*regexp.Regexp, error) {
+	flags := syntax.POSIX | syntax.ClassNL
+	if c.icase {
+		flags |= syntax.FoldCase
+	}
+	parsed, err := syntax.Parse(c.pattern, flags)
+	if err != nil {
+		return nil, err
+	}
+	re, err := regexp.Compile(parsed.String())
+	if err != nil {
+		return nil, err
+	}
+	re.Longest()
+	return re, nil
+}
+
+// result describes the outcome of a test case for one engine.
+func result(compiled bool, loc, want []int) string {
+	switch {
+	case !compiled:
+		return "compile error"
+	case loc == nil:
+		return "no match"
+	}
+	if len(loc) > len(want) {
+		loc = loc[:len(want)]
+	}
+	return fmt.Sprint(loc)
+}
+
+func sameLoc(loc, want []int) bool {
+	if (loc == nil) != (want == nil) {
+		return false
+	}
+	if len(loc) > len(want) {
+		loc = loc[:len(want)]
+	}
+	for i := range loc {
+		if loc[i] != want[i] {
+			return false
+		}
+	}
+	return true
+}
+
+// TestConformance runs each case on both engines. Package regexp must
+// give the expected result, as in exec_test.go; differences in the C
+// library are only logged, since few implementations get all of them
+// right.
+func TestConformance(t *testing.T) {
+	var goFail, cFail, differ, total int
+	for _, c := range loadCases(t) {
+		want := result(c.compile, c.pos, c.pos)
+
+		var goLoc []int
+		re, err := compileGo(c)
+		if err == nil {
+			goLoc = re.FindStringSubmatchIndex(c.text)
+		}
+		goRes := result(err == nil, goLoc, c.pos)
+
+		var cLoc []int
+		p, err := compilePOSIX(c.pattern, c.icase)
+		if err == nil {
+			text, err := newCText(c.text)
+			if err != nil {
+				p.free()
+				continue
+			}
+			cLoc = p.exec(text)
+			text.free()
+			p.free()
+		}
+		cRes := result(err == nil, cLoc, c.pos)
+
+		total++
+		if goRes != want {
+			goFail++
+			t.Errorf("%v: regexp: %#q on %#q: %s, want %s", c, c.pattern, c.text, goRes, want)
+		}
+		if cRes != want {
+			cFail++
+			t.Logf("%v: regexec: %#q on %#q: %s, want %s", c, c.pattern, c.text, cRes, want)
+		}
+		if goRes != cRes {
+			differ++
+		}
+	}
+	t.Logf("%d cases: regexp failed %d, regexec failed %d, results differ in %d", total, goFail, cFail, differ)
+}
+
+// BenchmarkCase reports the time each engine takes on each case that
+// both of them compile and agree on.
+func BenchmarkCase(b *testing.B) {
+	for _, c := range loadCases(b) {
+		if !c.compile {
+			continue
+		}
+		re, err := compileGo(c)
+		if err != nil {
+			continue
+		}
+		p, err := compilePOSIX(c.pattern, c.icase)
+		if err != nil {
+			continue
+		}
+		text, err := newCText(c.text)
+		if err != nil {
+			p.free()
+			continue
+		}
+		if !sameLoc(p.exec(text), re.FindStringSubmatchIndex(c.text)) {
+			text.free()
+			p.free()
+			continue
+		}
+		b.Run(c.String()+"/regexp", func(b *testing.B) {
+			b.SetBytes(int64(len(c.text)))
+			for i := 0; i < b.N; i++ {
+				re.FindStringSubmatchIndex(c.text)
+			}
+		})
+		b.Run(c.String()+"/regexec", func(b *testing.B) {
+			b.SetBytes(int64(len(c.text)))
+			for i := 0; i < b.N; i++ {
+				p.exec(text)
+			}
+		})
+		text.free()
+		p.free()
+	}
+}
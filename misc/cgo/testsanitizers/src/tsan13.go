@@ -0,0 +1,59 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+package main
+
+// This program exercises the paths at the cgo boundary that the C/C++
+// ThreadSanitizer slows down: calls into C, goroutines handing off
+// to each other, and threads being started. It should run without
+// reports, and is also used by BenchmarkTSAN.
+
+import (
+	"runtime"
+	"sync"
+)
+
+/*
+static int counter;
+
+static void inc(void) {
+	__atomic_add_fetch(&counter, 1, __ATOMIC_RELAXED);
+}
+*/
+import "C"
+
+func main() {
+	var wg sync.WaitGroup
+	for i := 0; i < 8; i++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			ping, pong := make(chan int), make(chan int)
+			go func() {
+				for v := range ping {
+					C.inc()
+					pong <- v
+				}
+				close(pong)
+			}()
+			for j := 0; j < 2000; j++ {
+				ping <- j
+				<-pong
+			}
+			close(ping)
+			<-pong
+		}()
+	}
+	for i := 0; i < 16; i++ {
+		wg.Add(1)
+		go func() {
+			// Exiting with the thread locked makes the runtime
+			// start a new one.
+			runtime.LockOSThread()
+			C.inc()
+			wg.Done()
+		}()
+	}
+	wg.Wait()
+}
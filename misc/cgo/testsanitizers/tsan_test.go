@@ -5,9 +5,12 @@
 package sanitizers_test
 
 import (
+	"io/ioutil"
+	"os"
+	"path/filepath"
+	"runtime"
 	"strings"
 	"testing"
-	"runtime"
 )
 
 func TestTSAN(t *testing.T) {
@@ -37,6 +40,7 @@ func TestTSAN(t *testing.T) {
 		{src: "tsan10.go", needsRuntime: true},
 		{src: "tsan11.go", needsRuntime: true},
 		{src: "tsan12.go", needsRuntime: true},
+		{src: "tsan13.go"},
 	}
 	for _, tc := range cases {
 		tc := tc
@@ -58,3 +62,29 @@ func TestTSAN(t *testing.T) {
 		})
 	}
 }
+
+// BenchmarkTSAN reports the time to run a program that makes many cgo
+// calls and goroutine switches with the C/C++ ThreadSanitizer.
+func BenchmarkTSAN(b *testing.B) {
+	config := configure("thread")
+	if skip, err := config.checkCSanitizer(); skip || err != nil {
+		b.Skipf("C compiler does not support -fsanitize=thread: %v", err)
+	}
+
+	dir, err := ioutil.TempDir("", "tsanbench")
+	if err != nil {
+		b.Fatal(err)
+	}
+	defer os.RemoveAll(dir)
+	outPath := filepath.Join(dir, "tsan13")
+	if out, err := config.goCmd("build", "-o", outPath, srcPath("tsan13.go")).CombinedOutput(); err != nil {
+		b.Fatalf("%v\n%s", err, out)
+	}
+
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if out, err := hangProneCmd(outPath).CombinedOutput(); err != nil {
+			b.Fatalf("%v\n%s", err, out)
+		}
+	}
+}
@@ -55,6 +55,33 @@ For example:
 
 The default pkg-config tool may be changed by setting the PKG_CONFIG environment variable.
 
+A C function that is expected to block for a long time, for example
+waiting for I/O or sleeping, may be listed in a '#cgo blocking' directive
+followed by the function names, with no colon.
+For example:
+
+	// #cgo blocking waitForEvent
+	// int waitForEvent(int fd);
+	import "C"
+
+A call to C.waitForEvent then gives up the goroutine's processor (P)
+as soon as it starts, as a blocking system call does, so that other
+goroutines can run without waiting for the scheduler to notice that
+the call is taking a long time. This makes the call itself somewhat
+more expensive, so it should not be used for functions that usually
+return quickly.
+
+Similarly, a function listed in a '#cgo async' directive is called
+without tying up a thread for the calling goroutine. The goroutine is
+parked, and the function runs on one of a limited pool of threads
+kept for such calls; see cgoasyncthreads in the runtime package
+documentation. Many goroutines can then wait for slow C calls at once
+without each using a thread, at the cost of a few microseconds per
+call. The function runs on a thread other than the caller's, so it
+must not depend on thread-local state, and it is called normally from
+a goroutine locked to its thread by runtime.LockOSThread. On systems
+other than Unix the directive has no effect.
+
 For security reasons, only a limited set of flags are allowed, notably -D, -I, and -l.
 To allow additional flags, set CGO_CFLAGS_ALLOW to a regular expression
 matching the new flags. To disallow flags that would otherwise be allowed,
@@ -320,6 +347,14 @@ definitions and declarations, then the two output files will produce
 duplicate symbols and the linker will fail. To avoid this, definitions
 must be placed in preambles in other files, or in C source files.
 
+A C API that takes a callback, such as qsort, needs a C function
+pointer rather than the name of an exported function. On Unix systems,
+runtime/cgo.NewCallback returns such a pointer for a Go function value,
+including a closure, whose arguments and result are pointer-sized:
+
+	cmp := cgo.NewCallback(func(a, b unsafe.Pointer) int {...})
+	C.qsort(base, n, size, (*[0]byte)(unsafe.Pointer(cmp)))
+
 Passing pointers
 
 Go is a garbage collected language, and the garbage collector needs to
@@ -368,6 +403,12 @@ Go code may not store a Go pointer in C memory. C code may store Go
 pointers in C memory, subject to the rule above: it must stop storing
 the Go pointer when the C function returns.
 
+These rules do not apply to Go pointers to objects pinned with a
+runtime.Pinner. Until the Pinner's Unpin method is called, such a
+pointer may be stored in Go memory passed to C, in C memory, and may
+be kept by C code after the call returns. This lets Go buffers be
+handed to asynchronous C interfaces without copying them.
+
 These rules are checked dynamically at runtime. The checking is
 controlled by the cgocheck setting of the GODEBUG environment
 variable. The default setting is GODEBUG=cgocheck=1, which implements
@@ -69,7 +69,8 @@ func cname(s string) string {
 
 // DiscardCgoDirectives processes the import C preamble, and discards
 // all #cgo CFLAGS and LDFLAGS directives, so they don't make their
-// way into _cgo_export.h.
+// way into _cgo_export.h. It records the functions named by #cgo
+// blocking and #cgo async directives in f.Blocking and f.Async.
 func (f *File) DiscardCgoDirectives() {
 	linesIn := strings.Split(f.Preamble, "\n")
 	linesOut := make([]string, 0, len(linesIn))
@@ -78,6 +79,21 @@ func (f *File) DiscardCgoDirectives() {
 		if len(l) < 5 || l[:4] != "#cgo" || !unicode.IsSpace(rune(l[4])) {
 			linesOut = append(linesOut, line)
 		} else {
+			if fields := strings.Fields(l[4:]); len(fields) > 0 {
+				var names *[]string
+				switch fields[0] {
+				case "blocking":
+					names = &f.Blocking
+				case "async":
+					names = &f.Async
+				}
+				if names != nil {
+					if len(fields) == 1 {
+						error_(token.NoPos, "missing function name in #cgo %s directive", fields[0])
+					}
+					*names = append(*names, fields[1:]...)
+				}
+			}
 			linesOut = append(linesOut, "")
 		}
 	}
@@ -46,6 +46,8 @@ type Package struct {
 	GoFiles     []string        // list of Go files
 	GccFiles    []string        // list of gcc output files
 	Preamble    string          // collected preamble for _cgo_export.h
+	Blocking    map[string]bool // C functions marked by #cgo blocking
+	Async       map[string]bool // C functions marked by #cgo async
 	typedefs    map[string]bool // type names that appear in the types of the objects we're interested in
 	typedefList []string
 }
@@ -56,6 +58,8 @@ type File struct {
 	Comments []*ast.CommentGroup // comments from file
 	Package  string              // Package name
 	Preamble string              // C preamble (doc comment on import "C")
+	Blocking []string            // C functions marked by #cgo blocking
+	Async    []string            // C functions marked by #cgo async
 	Ref      []*Ref              // all references to C.xxx in AST
 	Calls    []*Call             // all calls to C.xxx in AST
 	ExpFunc  []*ExpFunc          // exported functions for this file
@@ -413,6 +417,19 @@ func (p *Package) Record(f *File) {
 		}
 	}
 
+	for _, name := range f.Blocking {
+		if p.Blocking == nil {
+			p.Blocking = make(map[string]bool)
+		}
+		p.Blocking[name] = true
+	}
+	for _, name := range f.Async {
+		if p.Async == nil {
+			p.Async = make(map[string]bool)
+		}
+		p.Async[name] = true
+	}
+
 	if f.ExpFunc != nil {
 		p.ExpFunc = append(p.ExpFunc, f.ExpFunc...)
 		p.Preamble += "\n" + f.Preamble
@@ -59,12 +59,16 @@ func (p *Package) writeDefs() {
 		fmt.Fprintf(fm, "__SIZE_TYPE__ _cgo_wait_runtime_init_done() { return 0; }\n")
 		fmt.Fprintf(fm, "void _cgo_release_context(__SIZE_TYPE__ ctxt) { }\n")
 		fmt.Fprintf(fm, "char* _cgo_topofstack(void) { return (char*)0; }\n")
+		fmt.Fprintf(fm, "void _cgo_start_runtime(void) { }\n")
 	} else {
 		// If we're not importing runtime/cgo, we *are* runtime/cgo,
 		// which provides these functions. We just need a prototype.
-		fmt.Fprintf(fm, "void crosscall2(void(*fn)(void*, int, __SIZE_TYPE__), void *a, int c, __SIZE_TYPE__ ctxt);\n")
 		fmt.Fprintf(fm, "__SIZE_TYPE__ _cgo_wait_runtime_init_done();\n")
 		fmt.Fprintf(fm, "void _cgo_release_context(__SIZE_TYPE__);\n")
+		// These are written in Go, and called by runtime/cgo's
+		// callback trampolines.
+		fmt.Fprintf(fm, "void crosscall2(void(*fn)(void*, int, __SIZE_TYPE__), void *a, int c, __SIZE_TYPE__ ctxt) { }\n")
+		fmt.Fprintf(fm, "void _cgo_callback(void *a, int c, __SIZE_TYPE__ ctxt) { }\n")
 	}
 	fmt.Fprintf(fm, "void _cgo_allocate(void *a, int c) { }\n")
 	fmt.Fprintf(fm, "void _cgo_panic(void *a, int c) { }\n")
@@ -492,7 +496,14 @@ func (p *Package) writeDefsFunc(fgo2 io.Writer, n *Name, callsMalloc *bool) {
 	if n.AddError {
 		prefix = "errno := "
 	}
-	fmt.Fprintf(fgo2, "\t%s_cgo_runtime_cgocall(%s, %s)\n", prefix, cname, arg)
+	call := "_cgo_runtime_cgocall"
+	switch {
+	case p.Async[n.C]:
+		call = "_cgo_runtime_cgocallasync"
+	case p.Blocking[n.C]:
+		call = "_cgo_runtime_cgocallblock"
+	}
+	fmt.Fprintf(fgo2, "\t%s%s(%s, %s)\n", prefix, call, cname, arg)
 	if n.AddError {
 		fmt.Fprintf(fgo2, "\tif errno != 0 { r2 = syscall.Errno(errno) }\n")
 	}
@@ -596,7 +607,11 @@ func (p *Package) writeOutputFunc(fgcc *os.File, n *Name) {
 	// Use packed attribute to force no padding in this struct in case
 	// gcc has different packing requirements.
 	fmt.Fprintf(fgcc, "\t%s %v *_cgo_a = v;\n", ctype, p.packedAttribute())
-	if n.FuncType.Result != nil {
+	// An async call runs on a C worker thread, which has no g to
+	// find the stack top from, while the caller is parked; a parked
+	// goroutine's stack does not move.
+	adjust := n.FuncType.Result != nil && !p.Async[n.C]
+	if adjust {
 		// Save the stack top for use below.
 		fmt.Fprintf(fgcc, "\tchar *_cgo_stktop = _cgo_topofstack();\n")
 	}
@@ -631,10 +646,12 @@ func (p *Package) writeOutputFunc(fgcc *os.File, n *Name) {
 		fmt.Fprintf(fgcc, "\t_cgo_errno = errno;\n")
 	}
 	fmt.Fprintf(fgcc, "\t_cgo_tsan_release();\n")
-	if n.FuncType.Result != nil {
+	if adjust {
 		// The cgo call may have caused a stack copy (via a callback).
 		// Adjust the return value pointer appropriately.
 		fmt.Fprintf(fgcc, "\t_cgo_a = (void*)((char*)_cgo_a + (_cgo_topofstack() - _cgo_stktop));\n")
+	}
+	if n.FuncType.Result != nil {
 		// Save the return value.
 		fmt.Fprintf(fgcc, "\t_cgo_a->r = _cgo_r;\n")
 		// The return value is on the Go stack. If we are using msan,
@@ -747,6 +764,13 @@ func (p *Package) writeExports(fgo2, fm, fgcc, fgcch io.Writer) {
 	fmt.Fprintf(fgcc, "%s\n", tsanProlog)
 	fmt.Fprintf(fgcc, "%s\n", msanProlog)
 
+	if *exportHeader != "" && *importRuntimeCgo {
+		fmt.Fprintf(fgcc, "extern void _cgo_start_runtime(void);\n\n")
+		fmt.Fprintf(fgcc, "void %s(void) {\n", p.startRuntimeName())
+		fmt.Fprintf(fgcc, "\t_cgo_start_runtime();\n")
+		fmt.Fprintf(fgcc, "}\n")
+	}
+
 	for _, exp := range p.ExpFunc {
 		fn := exp.Func
 
@@ -865,7 +889,8 @@ func (p *Package) writeExports(fgo2, fm, fgcc, fgcch io.Writer) {
 		fmt.Fprintf(fgcc, "\t_cgo_tsan_release();\n")
 		fmt.Fprintf(fgcc, "\tcrosscall2(_cgoexp%s_%s, &a, %d, _cgo_ctxt);\n", cPrefix, exp.ExpName, off)
 		fmt.Fprintf(fgcc, "\t_cgo_tsan_acquire();\n")
-		fmt.Fprintf(fgcc, "\t_cgo_release_context(_cgo_ctxt);\n")
+		fmt.Fprintf(fgcc, "\tif (_cgo_ctxt != 0)\n")
+		fmt.Fprintf(fgcc, "\t\t_cgo_release_context(_cgo_ctxt);\n")
 		if gccResult != "void" {
 			if len(fntype.Results.List) == 1 && len(fntype.Results.List[0].Names) <= 1 {
 				fmt.Fprintf(fgcc, "\treturn a.r0;\n")
@@ -1165,6 +1190,33 @@ func (p *Package) writeExportHeader(fgcch io.Writer) {
 	fmt.Fprintf(fgcch, "\n/* End of preamble from import \"C\" comments.  */\n\n")
 
 	fmt.Fprintf(fgcch, "%s\n", p.gccExportHeaderProlog())
+
+	if *exportHeader != "" && *importRuntimeCgo && !*gccgo {
+		fmt.Fprintf(fgcch, "/* Start the Go runtime in the background, for a library loaded with\n")
+		fmt.Fprintf(fgcch, "   GODEBUG=cgolazyinit=1. See the runtime package documentation.  */\n")
+		fmt.Fprintf(fgcch, "extern void %s(void);\n\n", p.startRuntimeName())
+	}
+}
+
+// startRuntimeName returns the name of the function that a C program
+// calls to start the Go runtime of a library built with
+// -buildmode=c-archive or -buildmode=c-shared. The name includes the
+// package import path, so that several Go libraries linked into the
+// same program each have their own.
+func (p *Package) startRuntimeName() string {
+	pkg := *importPath
+	if pkg == "" {
+		pkg = p.PackagePath
+	}
+	clean := func(r rune) rune {
+		switch {
+		case 'A' <= r && r <= 'Z', 'a' <= r && r <= 'z',
+			'0' <= r && r <= '9':
+			return r
+		}
+		return '_'
+	}
+	return "GoStartRuntime_" + strings.Map(clean, pkg)
 }
 
 // Return the package prefix when using gccgo.
@@ -1442,6 +1494,12 @@ const goProlog = `
 //go:linkname _cgo_runtime_cgocall runtime.cgocall
 func _cgo_runtime_cgocall(unsafe.Pointer, uintptr) int32
 
+//go:linkname _cgo_runtime_cgocallblock runtime.cgocallblock
+func _cgo_runtime_cgocallblock(unsafe.Pointer, uintptr) int32
+
+//go:linkname _cgo_runtime_cgocallasync runtime.cgocallasync
+func _cgo_runtime_cgocallasync(unsafe.Pointer, uintptr) int32
+
 //go:linkname _cgo_runtime_cgocallback runtime.cgocallback
 func _cgo_runtime_cgocallback(unsafe.Pointer, unsafe.Pointer, uintptr, uintptr)
 
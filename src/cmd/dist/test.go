@@ -619,9 +619,20 @@ func (t *tester) registerTests() {
 			heading: "../misc/cgo/life",
 			fn: func(dt *distTest) error {
 				t.addCmd(dt, "misc/cgo/life", "go", "run", filepath.Join(os.Getenv("GOROOT"), "test/run.go"), "-", ".")
+				t.addCmd(dt, "misc/cgo/life", t.goTest())
 				return nil
 			},
 		})
+		if goos != "windows" && goos != "android" {
+			t.tests = append(t.tests, distTest{
+				name:    "cgo_testregex",
+				heading: "../misc/cgo/testregex",
+				fn: func(dt *distTest) error {
+					t.addCmd(dt, "misc/cgo/testregex", t.goTest())
+					return nil
+				},
+			})
+		}
 		fortran := os.Getenv("FC")
 		if fortran == "" {
 			fortran, _ = exec.LookPath("gfortran")
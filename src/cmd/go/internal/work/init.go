@@ -195,6 +195,14 @@ func buildModeInit() {
 		base.Fatalf("buildmode=%s not supported", cfg.BuildBuildmode)
 	}
 	if cfg.BuildLinkshared {
+		switch cfg.BuildBuildmode {
+		case "c-archive", "c-shared":
+			// The library must carry its own copy of the
+			// runtime, which starts when it is loaded.
+			if !gccgo {
+				base.Fatalf("-linkshared not supported with -buildmode=%s\n", cfg.BuildBuildmode)
+			}
+		}
 		if gccgo {
 			codegenArg = "-fPIC"
 		} else {
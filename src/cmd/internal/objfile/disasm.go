@@ -17,6 +17,7 @@ import (
 	"os"
 	"path/filepath"
 	"regexp"
+	"runtime"
 	"sort"
 	"strings"
 	"text/tabwriter"
@@ -182,6 +183,9 @@ func (fc *FileCache) Line(filename string, line int) ([]byte, error) {
 // If filter is non-nil, the disassembly only includes functions with names matching filter.
 // If printCode is true, the disassembly includs corresponding source lines.
 // The disassembly only includes functions that overlap the range [start, end).
+//
+// The functions are disassembled in parallel where the decoder allows
+// it, and printed in order as soon as each one is ready.
 func (d *Disasm) Print(w io.Writer, filter *regexp.Regexp, start, end uint64, printCode bool) {
 	if start < d.textStart {
 		start = d.textStart
@@ -189,44 +193,75 @@ func (d *Disasm) Print(w io.Writer, filter *regexp.Regexp, start, end uint64, pr
 	if end > d.textEnd {
 		end = d.textEnd
 	}
-	printed := false
-	bw := bufio.NewWriter(w)
-
-	var fc *FileCache
-	if printCode {
-		fc = NewFileCache(8)
-	}
-
-	tw := tabwriter.NewWriter(bw, 18, 8, 1, '\t', tabwriter.StripEscape)
+	var syms []Sym
 	for _, sym := range d.syms {
 		symStart := sym.Addr
 		symEnd := sym.Addr + uint64(sym.Size)
-		relocs := sym.Relocs
 		if sym.Code != 'T' && sym.Code != 't' ||
 			symStart < d.textStart ||
 			symEnd <= start || end <= symStart ||
 			filter != nil && !filter.MatchString(sym.Name) {
 			continue
 		}
-		if printed {
+		syms = append(syms, sym)
+	}
+
+	// Disassemble the symbols on parallel workers, staying at most
+	// a few symbols ahead of the printing below.
+	nworker := 1
+	switch d.goarch {
+	case "386", "amd64", "amd64p32":
+		// The other decoders record coverage data in shared
+		// variables, so they are not safe for concurrent use.
+		nworker = runtime.GOMAXPROCS(0)
+	}
+	texts := make([]chan *symText, len(syms))
+	for i := range texts {
+		texts[i] = make(chan *symText, 1)
+	}
+	window := make(chan bool, 4*nworker)
+	jobs := make(chan int)
+	go func() {
+		for i := range syms {
+			window <- true
+			jobs <- i
+		}
+		close(jobs)
+	}()
+	for n := 0; n < nworker; n++ {
+		go func() {
+			for i := range jobs {
+				texts[i] <- d.disasmSym(syms[i], end)
+			}
+		}()
+	}
+
+	bw := bufio.NewWriter(w)
+
+	var fc *FileCache
+	if printCode {
+		fc = NewFileCache(8)
+	}
+
+	tw := tabwriter.NewWriter(bw, 18, 8, 1, '\t', tabwriter.StripEscape)
+	for i, sym := range syms {
+		st := <-texts[i]
+		<-window
+		if i > 0 {
 			fmt.Fprintf(bw, "\n")
 		}
-		printed = true
 
 		file, _, _ := d.pcln.PCToLine(sym.Addr)
 		fmt.Fprintf(bw, "TEXT %s(SB) %s\n", sym.Name, file)
 
-		if symEnd > end {
-			symEnd = end
-		}
-		code := d.text[:end-d.textStart]
-
 		var lastFile string
 		var lastLine int
 
-		d.Decode(symStart, symEnd, relocs, func(pc, size uint64, file string, line int, text string) {
-			i := pc - d.textStart
-
+		text := st.text.Bytes()
+		for _, inst := range st.insts {
+			// The pcln table is not safe for concurrent use,
+			// so the workers leave the line numbers to us.
+			file, line, _ := d.pcln.PCToLine(inst.pc)
 			if printCode {
 				if file != lastFile || line != lastLine {
 					if srcLine, err := fc.Line(file, line); err == nil {
@@ -236,32 +271,70 @@ func (d *Disasm) Print(w io.Writer, filter *regexp.Regexp, start, end uint64, pr
 					lastFile, lastLine = file, line
 				}
 
-				fmt.Fprintf(tw, "  %#x\t", pc)
-			} else {
-				fmt.Fprintf(tw, "  %s:%d\t%#x\t", base(file), line, pc)
-			}
-
-			if size%4 != 0 || d.goarch == "386" || d.goarch == "amd64" || d.goarch == "amd64p32" {
-				// Print instruction as bytes.
-				fmt.Fprintf(tw, "%x", code[i:i+size])
+				fmt.Fprintf(tw, "  ")
 			} else {
-				// Print instruction as 32-bit words.
-				for j := uint64(0); j < size; j += 4 {
-					if j > 0 {
-						fmt.Fprintf(tw, " ")
-					}
-					fmt.Fprintf(tw, "%08x", d.byteOrder.Uint32(code[i+j:]))
-				}
+				fmt.Fprintf(tw, "  %s:%d\t", base(file), line)
 			}
-			fmt.Fprintf(tw, "\t%s\t\n", text)
-		})
+			tw.Write(text[:inst.len])
+			text = text[inst.len:]
+		}
 		tw.Flush()
 	}
 	bw.Flush()
 }
 
+// A symText is the disassembly of a symbol, without line numbers.
+type symText struct {
+	text  bytes.Buffer // the instructions, one line each
+	insts []symInst
+}
+
+type symInst struct {
+	pc  uint64
+	len int // length of the line in text
+}
+
+// disasmSym disassembles sym, up to end.
+func (d *Disasm) disasmSym(sym Sym, end uint64) *symText {
+	symEnd := sym.Addr + uint64(sym.Size)
+	if symEnd > end {
+		symEnd = end
+	}
+	code := d.text[:end-d.textStart]
+	st := new(symText)
+	d.decode(sym.Addr, symEnd, sym.Relocs, func(pc, size uint64, text string) {
+		i := pc - d.textStart
+		n := st.text.Len()
+		fmt.Fprintf(&st.text, "%#x\t", pc)
+		if size%4 != 0 || d.goarch == "386" || d.goarch == "amd64" || d.goarch == "amd64p32" {
+			// Print instruction as bytes.
+			fmt.Fprintf(&st.text, "%x", code[i:i+size])
+		} else {
+			// Print instruction as 32-bit words.
+			for j := uint64(0); j < size; j += 4 {
+				if j > 0 {
+					fmt.Fprintf(&st.text, " ")
+				}
+				fmt.Fprintf(&st.text, "%08x", d.byteOrder.Uint32(code[i+j:]))
+			}
+		}
+		fmt.Fprintf(&st.text, "\t%s\t\n", text)
+		st.insts = append(st.insts, symInst{pc, st.text.Len() - n})
+	})
+	return st
+}
+
 // Decode disassembles the text segment range [start, end), calling f for each instruction.
 func (d *Disasm) Decode(start, end uint64, relocs []Reloc, f func(pc, size uint64, file string, line int, text string)) {
+	d.decode(start, end, relocs, func(pc, size uint64, text string) {
+		file, line, _ := d.pcln.PCToLine(pc)
+		f(pc, size, file, line, text)
+	})
+}
+
+// decode is like Decode but does not look up line numbers,
+// so that it can run on several goroutines at once.
+func (d *Disasm) decode(start, end uint64, relocs []Reloc, f func(pc, size uint64, text string)) {
 	if start < d.textStart {
 		start = d.textStart
 	}
@@ -273,14 +346,13 @@ func (d *Disasm) Decode(start, end uint64, relocs []Reloc, f func(pc, size uint6
 	for pc := start; pc < end; {
 		i := pc - d.textStart
 		text, size := d.disasm(code[i:], pc, lookup, d.byteOrder)
-		file, line, _ := d.pcln.PCToLine(pc)
 		sep := "\t"
 		for len(relocs) > 0 && relocs[0].Addr < i+uint64(size) {
 			text += sep + relocs[0].Stringer.String(pc-start)
 			sep = " "
 			relocs = relocs[1:]
 		}
-		f(pc, uint64(size), file, line, text)
+		f(pc, uint64(size), text)
 		pc += uint64(size)
 	}
 }
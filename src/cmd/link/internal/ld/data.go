@@ -42,6 +42,7 @@ import (
 	"fmt"
 	"log"
 	"os"
+	"runtime"
 	"sort"
 	"strconv"
 	"strings"
@@ -505,15 +506,59 @@ func (ctxt *Link) reloc() {
 		ctxt.Logf("%5.2f reloc\n", Cputime())
 	}
 
-	for _, s := range ctxt.Textp {
-		relocsym(ctxt, s)
+	// In shared builds relocsym may retype the target of an
+	// unresolved relocation, so keep those sequential.
+	if ctxt.BuildMode == BuildModeShared {
+		for _, s := range ctxt.Textp {
+			relocsym(ctxt, s)
+		}
+		for _, s := range datap {
+			relocsym(ctxt, s)
+		}
+		for _, s := range dwarfp {
+			relocsym(ctxt, s)
+		}
+		return
 	}
-	for _, s := range datap {
-		relocsym(ctxt, s)
+
+	// Otherwise relocsym only writes to the contents and
+	// relocations of the symbol it is given, and symbol addresses
+	// are fixed by now, so symbols can be relocated concurrently
+	// without affecting the output. Hand out runs of symbols to
+	// keep the per-symbol overhead low.
+	//
+	// On several architectures archreloc looks up these symbols
+	// by name. Lookup adds a symbol that is missing to the symbol
+	// table, so do that here, leaving the workers only reading it.
+	for _, name := range []string{".got", ".plt", ".got.plt"} {
+		ctxt.Syms.Lookup(name, 0)
+	}
+	const chunk = 256
+	work := make(chan []*sym.Symbol)
+	var wg sync.WaitGroup
+	for i := 0; i < runtime.GOMAXPROCS(0); i++ {
+		wg.Add(1)
+		go func() {
+			for syms := range work {
+				for _, s := range syms {
+					relocsym(ctxt, s)
+				}
+			}
+			wg.Done()
+		}()
 	}
-	for _, s := range dwarfp {
-		relocsym(ctxt, s)
+	for _, syms := range [][]*sym.Symbol{ctxt.Textp, datap, dwarfp} {
+		for len(syms) > 0 {
+			n := chunk
+			if n > len(syms) {
+				n = len(syms)
+			}
+			work <- syms[:n]
+			syms = syms[n:]
+		}
 	}
+	close(work)
+	wg.Wait()
 }
 
 func windynrelocsym(ctxt *Link, s *sym.Symbol) {
@@ -37,6 +37,7 @@ import (
 	"cmd/link/internal/sym"
 	"debug/elf"
 	"fmt"
+	"sync"
 )
 
 type Shlib struct {
@@ -85,7 +86,8 @@ type Link struct {
 
 	// unresolvedSymSet is a set of erroneous unresolved references.
 	// Used to avoid duplicated error messages.
-	unresolvedSymSet map[unresolvedSymKey]bool
+	unresolvedSymSet   map[unresolvedSymKey]bool
+	unresolvedSymSetMu sync.Mutex
 
 	// Used to implement field tracking.
 	Reachparent map[*sym.Symbol]*sym.Symbol
@@ -98,6 +100,8 @@ type unresolvedSymKey struct {
 
 // ErrorUnresolved prints unresolved symbol error for r.Sym that is referenced from s.
 func (ctxt *Link) ErrorUnresolved(s *sym.Symbol, r *sym.Reloc) {
+	ctxt.unresolvedSymSetMu.Lock()
+	defer ctxt.unresolvedSymSetMu.Unlock()
 	if ctxt.unresolvedSymSet == nil {
 		ctxt.unresolvedSymSet = make(map[unresolvedSymKey]bool)
 	}
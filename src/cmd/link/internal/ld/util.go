@@ -9,6 +9,7 @@ import (
 	"encoding/binary"
 	"fmt"
 	"os"
+	"sync"
 	"time"
 )
 
@@ -43,6 +44,9 @@ func Exitf(format string, a ...interface{}) {
 	Exit(2)
 }
 
+// errorMu serializes Errorf.
+var errorMu sync.Mutex
+
 // Errorf logs an error message.
 //
 // If more than 20 errors have been printed, exit with an error.
@@ -54,6 +58,9 @@ func Errorf(s *sym.Symbol, format string, args ...interface{}) {
 		format = s.Name + ": " + format
 	}
 	format += "\n"
+	// Relocation runs in parallel and may report errors.
+	errorMu.Lock()
+	defer errorMu.Unlock()
 	fmt.Fprintf(os.Stderr, format, args...)
 	nerrors++
 	if *flagH {
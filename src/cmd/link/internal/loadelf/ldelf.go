@@ -136,6 +136,11 @@ const (
 	ElfSymBindLocal  = 0
 	ElfSymBindGlobal = 1
 	ElfSymBindWeak   = 2
+
+	// GNU extension: the dynamic linker uses a single definition
+	// process-wide. gcc emits it for static locals of inline
+	// functions, which normally live in COMDAT groups.
+	ElfSymBindGnuUnique = 10
 )
 
 const (
@@ -181,7 +186,10 @@ const (
 	ELF64SYMSIZE = 24
 	ELF32SYMSIZE = 16
 
+	SHT_GROUP          = 17
 	SHT_ARM_ATTRIBUTES = 0x70000003
+
+	GRP_COMDAT = 0x1
 )
 
 type ElfHdrBytes struct {
@@ -282,6 +290,10 @@ type ElfSect struct {
 	entsize uint64
 	base    []byte
 	sym     *sym.Symbol
+
+	// discarded is set for the members of a COMDAT group that
+	// was already loaded from an earlier object.
+	discarded bool
 }
 
 type ElfObj struct {
@@ -672,6 +684,41 @@ func Load(arch *sys.Arch, syms *sym.Symbols, f *bio.Reader, pkg string, length i
 		return errorf("malformed elf file: %v", err)
 	}
 
+	// Discard COMDAT groups that an earlier object already
+	// provided. C++ compilers emit every inline function and
+	// template instantiation in its own group, so a library built
+	// from many files carries many copies of each one.
+	for i := 0; uint(i) < elfobj.nsect; i++ {
+		sect = &elfobj.sect[i]
+		if sect.type_ != SHT_GROUP {
+			continue
+		}
+		if err := elfmap(elfobj, sect); err != nil {
+			return errorf("malformed elf file: %v", err)
+		}
+		if len(sect.base) < 4 || e.Uint32(sect.base)&GRP_COMDAT == 0 {
+			continue
+		}
+		// The group's signature symbol names it. If that
+		// symbol is already defined by an ELF section, an
+		// earlier object loaded the group.
+		var sig ElfSym
+		if err := readelfsym(arch, syms, elfobj, int(sect.info), &sig, 0, 0); err != nil {
+			return errorf("malformed elf file: %v", err)
+		}
+		if sig.name == "" || sig.bind == ElfSymBindLocal {
+			continue
+		}
+		if s := syms.ROLookup(sig.name, 0); s == nil || s.Outer == nil {
+			continue
+		}
+		for p := sect.base[4:]; len(p) >= 4; p = p[4:] {
+			if k := e.Uint32(p); k < uint32(elfobj.nsect) {
+				elfobj.sect[k].discarded = true
+			}
+		}
+	}
+
 	// load text and data segments into memory.
 	// they are not as small as the section lists, but we'll need
 	// the memory anyway for the symbol images, so we might
@@ -680,6 +727,9 @@ func Load(arch *sys.Arch, syms *sym.Symbols, f *bio.Reader, pkg string, length i
 	// create symbols for elfmapped sections
 	for i := 0; uint(i) < elfobj.nsect; i++ {
 		sect = &elfobj.sect[i]
+		if sect.discarded {
+			continue
+		}
 		if sect.type_ == SHT_ARM_ATTRIBUTES && sect.name == ".ARM.attributes" {
 			if err := elfmap(elfobj, sect); err != nil {
 				return errorf("%s: malformed elf file: %v", pn, err)
@@ -776,6 +826,15 @@ func Load(arch *sys.Arch, syms *sym.Symbols, f *bio.Reader, pkg string, length i
 		}
 		sect = &elfobj.sect[elfsym.shndx]
 		if sect.sym == nil {
+			if sect.discarded {
+				// Local symbols go with their discarded
+				// group; references to global ones resolve
+				// to the copy that was kept.
+				if elfsym.bind == ElfSymBindLocal {
+					symbols[i] = nil
+				}
+				continue
+			}
 			if strings.HasPrefix(elfsym.name, ".Linfo_string") { // clang does this
 				continue
 			}
@@ -911,16 +970,31 @@ func Load(arch *sys.Arch, syms *sym.Symbols, f *bio.Reader, pkg string, length i
 			if info>>32 == 0 { // absolute relocation, don't bother reading the null symbol
 				rp.Sym = nil
 			} else {
-				var elfsym ElfSym
-				if err := readelfsym(arch, syms, elfobj, int(info>>32), &elfsym, 0, 0); err != nil {
-					return errorf("malformed elf file: %v", err)
+				// The symbols were all read above; only go
+				// back to the symbol table for one that has
+				// no symbol.
+				if info>>32 >= uint64(elfobj.nsymtab) {
+					return errorf("malformed elf file: %s#%d: reloc of invalid sym #%d", sect.sym.Name, j, int(info>>32))
 				}
-				elfsym.sym = symbols[info>>32]
-				if elfsym.sym == nil {
+				rp.Sym = symbols[info>>32]
+				if rp.Sym == nil {
+					var elfsym ElfSym
+					if err := readelfsym(arch, syms, elfobj, int(info>>32), &elfsym, 0, 0); err != nil {
+						return errorf("malformed elf file: %v", err)
+					}
+					if uint(elfsym.shndx) < elfobj.nsect && elfobj.sect[elfsym.shndx].discarded {
+						// A kept section, such as .eh_frame,
+						// refers to a local symbol of a
+						// discarded COMDAT group. Drop the
+						// relocation, leaving the field as
+						// it is in the object, as the system
+						// linkers do for such references.
+						j--
+						n--
+						continue
+					}
 					return errorf("malformed elf file: %s#%d: reloc of invalid sym #%d %s shndx=%d type=%d", sect.sym.Name, j, int(info>>32), elfsym.name, elfsym.shndx, elfsym.type_)
 				}
-
-				rp.Sym = elfsym.sym
 			}
 
 			rp.Type = 256 + objabi.RelocType(info)
@@ -1001,27 +1075,29 @@ func readelfsym(arch *sys.Arch, syms *sym.Symbols, elfobj *ElfObj, i int, elfsym
 		return fmt.Errorf("readym: read null symbol!")
 	}
 
+	// Decode the fields directly rather than through binary.Read;
+	// this runs for every symbol of every host object.
+	e := elfobj.e
+	var info uint8
 	if elfobj.is64 != 0 {
-		b := new(ElfSymBytes64)
-		binary.Read(bytes.NewReader(elfobj.symtab.base[i*ELF64SYMSIZE:(i+1)*ELF64SYMSIZE]), elfobj.e, b)
-		elfsym.name = cstring(elfobj.symstr.base[elfobj.e.Uint32(b.Name[:]):])
-		elfsym.value = elfobj.e.Uint64(b.Value[:])
-		elfsym.size = elfobj.e.Uint64(b.Size[:])
-		elfsym.shndx = elfobj.e.Uint16(b.Shndx[:])
-		elfsym.bind = b.Info >> 4
-		elfsym.type_ = b.Info & 0xf
-		elfsym.other = b.Other
+		b := elfobj.symtab.base[i*ELF64SYMSIZE : (i+1)*ELF64SYMSIZE]
+		elfsym.name = cstring(elfobj.symstr.base[e.Uint32(b[0:]):])
+		info = b[4]
+		elfsym.other = b[5]
+		elfsym.shndx = e.Uint16(b[6:])
+		elfsym.value = e.Uint64(b[8:])
+		elfsym.size = e.Uint64(b[16:])
 	} else {
-		b := new(ElfSymBytes)
-		binary.Read(bytes.NewReader(elfobj.symtab.base[i*ELF32SYMSIZE:(i+1)*ELF32SYMSIZE]), elfobj.e, b)
-		elfsym.name = cstring(elfobj.symstr.base[elfobj.e.Uint32(b.Name[:]):])
-		elfsym.value = uint64(elfobj.e.Uint32(b.Value[:]))
-		elfsym.size = uint64(elfobj.e.Uint32(b.Size[:]))
-		elfsym.shndx = elfobj.e.Uint16(b.Shndx[:])
-		elfsym.bind = b.Info >> 4
-		elfsym.type_ = b.Info & 0xf
-		elfsym.other = b.Other
+		b := elfobj.symtab.base[i*ELF32SYMSIZE : (i+1)*ELF32SYMSIZE]
+		elfsym.name = cstring(elfobj.symstr.base[e.Uint32(b[0:]):])
+		elfsym.value = uint64(e.Uint32(b[4:]))
+		elfsym.size = uint64(e.Uint32(b[8:]))
+		info = b[12]
+		elfsym.other = b[13]
+		elfsym.shndx = e.Uint16(b[14:])
 	}
+	elfsym.bind = info >> 4
+	elfsym.type_ = info & 0xf
 
 	var s *sym.Symbol
 	if elfsym.name == "_GLOBAL_OFFSET_TABLE_" {
@@ -1082,7 +1158,7 @@ func readelfsym(arch *sys.Arch, syms *sym.Symbols, elfobj *ElfObj, i int, elfsym
 				s.Attr |= sym.AttrVisibilityHidden
 			}
 
-		case ElfSymBindWeak:
+		case ElfSymBindWeak, ElfSymBindGnuUnique:
 			if needSym != 0 {
 				s = syms.Lookup(elfsym.name, 0)
 				if elfsym.other == 2 {
@@ -1,11 +1,15 @@
 package main
 
 import (
+	"bytes"
+	"fmt"
 	"internal/testenv"
 	"io/ioutil"
 	"os"
 	"os/exec"
 	"path/filepath"
+	"runtime"
+	"strings"
 	"testing"
 )
 
@@ -70,3 +74,178 @@ func main() {}
 		t.Fatalf("failed to link main.o: %v, output: %s\n", err, out)
 	}
 }
+
+// writeCXXProgram writes a cgo program to dir whose n C++ files all
+// instantiate the same inline functions. With -ffunction-sections each
+// copy lands in its own COMDAT group, which the internal linker must
+// load only once. The functions are not inlined, so that the .eh_frame
+// of each file refers to the sections of its copies.
+func writeCXXProgram(t testing.TB, dir string, n int) {
+	const header = `
+template <typename T> __attribute__((noinline)) T twice(T x) { return x + x; }
+__attribute__((noinline)) inline int shared(int x) { static int calls; calls++; return twice(x) + calls - calls; }
+`
+	if err := ioutil.WriteFile(filepath.Join(dir, "inl.h"), []byte(header), 0666); err != nil {
+		t.Fatal(err)
+	}
+	var decls, calls bytes.Buffer
+	for i := 0; i < n; i++ {
+		src := fmt.Sprintf("#include \"inl.h\"\nextern \"C\" int f%d(int x) { return shared(x) + twice<long>(x) + %d; }\n", i, i)
+		if err := ioutil.WriteFile(filepath.Join(dir, fmt.Sprintf("f%d.cc", i)), []byte(src), 0666); err != nil {
+			t.Fatal(err)
+		}
+		fmt.Fprintf(&decls, "// int f%d(int);\n", i)
+		fmt.Fprintf(&calls, "\tsum += int(C.f%d(1))\n", i)
+	}
+	main := fmt.Sprintf("package main\n\n%simport \"C\"\n\nimport \"fmt\"\n\nfunc main() {\n\tsum := 0\n%s\tfmt.Println(sum)\n}\n", decls.Bytes(), calls.Bytes())
+	if err := ioutil.WriteFile(filepath.Join(dir, "main.go"), []byte(main), 0666); err != nil {
+		t.Fatal(err)
+	}
+}
+
+func buildCXXProgram(t testing.TB, dir string) {
+	cmd := exec.Command(testenv.GoToolPath(t), "build", "-ldflags=-linkmode=internal", "-o", "cxx.exe")
+	cmd.Dir = dir
+	cmd.Env = append(os.Environ(), "CGO_CXXFLAGS=-O2 -ffunction-sections -fno-exceptions")
+	if out, err := cmd.CombinedOutput(); err != nil {
+		t.Fatalf("go build failed: %v\n%s", err, out)
+	}
+}
+
+func TestInternalLinkCXXComdat(t *testing.T) {
+	testenv.MustHaveGoBuild(t)
+	testenv.MustHaveCGO(t)
+	if runtime.GOOS != "linux" || runtime.GOARCH != "amd64" {
+		t.Skipf("skipping on %s/%s", runtime.GOOS, runtime.GOARCH)
+	}
+	if _, err := exec.LookPath("g++"); err != nil {
+		t.Skip("skipping without g++")
+	}
+
+	tmpdir, err := ioutil.TempDir("", "cxxcomdat")
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer os.RemoveAll(tmpdir)
+
+	const n = 20
+	writeCXXProgram(t, tmpdir, n)
+	buildCXXProgram(t, tmpdir)
+	out, err := exec.Command(filepath.Join(tmpdir, "cxx.exe")).CombinedOutput()
+	if err != nil {
+		t.Fatalf("program failed: %v\n%s", err, out)
+	}
+	if got, want := strings.TrimSpace(string(out)), fmt.Sprint(4*n+n*(n-1)/2); got != want {
+		t.Errorf("program printed %s, want %s", got, want)
+	}
+
+	// The sections of the discarded copies must not be in the
+	// output. The linker names the symbol of a section loaded
+	// from a host object pkg(section).
+	out, err = exec.Command(testenv.GoToolPath(t), "tool", "nm", filepath.Join(tmpdir, "cxx.exe")).CombinedOutput()
+	if err != nil {
+		t.Fatalf("go tool nm failed: %v\n%s", err, out)
+	}
+	sects := make(map[string]int)
+	for _, line := range strings.Split(string(out), "\n") {
+		f := strings.Fields(line)
+		if len(f) == 3 && strings.HasPrefix(f[2], "main(") && strings.Contains(f[2], "._Z") {
+			sects[f[2]]++
+		}
+	}
+	for _, name := range []string{
+		"main(.text._Z6sharedi)",
+		"main(.text._Z5twiceIiET_S0_)",
+		"main(.text._Z5twiceIlET_S0_)",
+		"main(.bss._ZZ6sharediE5calls)",
+	} {
+		if sects[name] != 1 {
+			t.Errorf("%d copies of section %s in output, want 1", sects[name], name)
+		}
+	}
+	if len(sects) != 4 {
+		t.Errorf("COMDAT sections in output: %v", sects)
+	}
+}
+
+func BenchmarkInternalLinkCXX(b *testing.B) {
+	testenv.MustHaveGoBuild(b)
+	testenv.MustHaveCGO(b)
+	if runtime.GOOS != "linux" || runtime.GOARCH != "amd64" {
+		b.Skipf("skipping on %s/%s", runtime.GOOS, runtime.GOARCH)
+	}
+	if _, err := exec.LookPath("g++"); err != nil {
+		b.Skip("skipping without g++")
+	}
+
+	tmpdir, err := ioutil.TempDir("", "cxxcomdat")
+	if err != nil {
+		b.Fatal(err)
+	}
+	defer os.RemoveAll(tmpdir)
+
+	writeCXXProgram(b, tmpdir, 500)
+	// The first build compiles the C++ files into the build
+	// cache; later ones only relink.
+	buildCXXProgram(b, tmpdir)
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		os.Remove(filepath.Join(tmpdir, "cxx.exe"))
+		buildCXXProgram(b, tmpdir)
+	}
+}
+
+// BenchmarkLinkLarge measures relinking a synthetic program with
+// many functions and data symbols, and hence many relocations.
+func BenchmarkLinkLarge(b *testing.B) {
+	testenv.MustHaveGoBuild(b)
+
+	tmpdir, err := ioutil.TempDir("", "linklarge")
+	if err != nil {
+		b.Fatal(err)
+	}
+	defer os.RemoveAll(tmpdir)
+
+	const nfile, nfunc = 20, 1000
+	for i := 0; i < nfile; i++ {
+		var buf bytes.Buffer
+		fmt.Fprintf(&buf, "package main\n\nimport \"fmt\"\n\n")
+		for j := 0; j < nfunc; j++ {
+			fmt.Fprintf(&buf, "var s%d_%d = []string{\"a%d_%d\", \"b%d_%d\"}\n\n", i, j, i, j, i, j)
+			fmt.Fprintf(&buf, "func f%d_%d(x int) string {\n\tif x > %d {\n\t\treturn fmt.Sprint(x, s%d_%d)\n\t}\n\treturn s%d_%d[x&1]\n}\n\n", i, j, j, i, j, i, j)
+		}
+		fmt.Fprintf(&buf, "var tab%d = []func(int) string{\n", i)
+		for j := 0; j < nfunc; j++ {
+			fmt.Fprintf(&buf, "\tf%d_%d,\n", i, j)
+		}
+		fmt.Fprintf(&buf, "}\n")
+		if err := ioutil.WriteFile(filepath.Join(tmpdir, fmt.Sprintf("f%d.go", i)), buf.Bytes(), 0666); err != nil {
+			b.Fatal(err)
+		}
+	}
+	var buf bytes.Buffer
+	fmt.Fprintf(&buf, "package main\n\nimport \"os\"\n\nfunc main() {\n\tn := len(os.Args)\n")
+	for i := 0; i < nfile; i++ {
+		fmt.Fprintf(&buf, "\tprintln(tab%d[n](n))\n", i)
+	}
+	fmt.Fprintf(&buf, "}\n")
+	if err := ioutil.WriteFile(filepath.Join(tmpdir, "main.go"), buf.Bytes(), 0666); err != nil {
+		b.Fatal(err)
+	}
+
+	build := func() {
+		cmd := exec.Command(testenv.GoToolPath(b), "build", "-o", "large.exe")
+		cmd.Dir = tmpdir
+		if out, err := cmd.CombinedOutput(); err != nil {
+			b.Fatalf("go build failed: %v\n%s", err, out)
+		}
+	}
+	// The first build compiles the package into the build cache;
+	// later ones only relink.
+	build()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		os.Remove(filepath.Join(tmpdir, "large.exe"))
+		build()
+	}
+}
@@ -251,3 +251,22 @@ func TestDisasmGoobj(t *testing.T) {
 		t.Logf("full disassembly:\n%s", text)
 	}
 }
+
+// BenchmarkDisasm disassembles the compiler, a large binary.
+func BenchmarkDisasm(b *testing.B) {
+	compile := filepath.Join(build.ToolDir, "compile")
+	if runtime.GOOS == "windows" {
+		compile += ".exe"
+	}
+	if _, err := os.Stat(compile); err != nil {
+		b.Skip(err)
+	}
+	for i := 0; i < b.N; i++ {
+		cmd := exec.Command(exe, compile)
+		cmd.Stdout = ioutil.Discard
+		cmd.Stderr = os.Stderr
+		if err := cmd.Run(); err != nil {
+			b.Fatalf("objdump %s: %v", compile, err)
+		}
+	}
+}
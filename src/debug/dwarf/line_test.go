@@ -6,7 +6,10 @@ package dwarf_test
 
 import (
 	. "debug/dwarf"
+	"debug/elf"
 	"io"
+	"path/filepath"
+	"runtime"
 	"strings"
 	"testing"
 )
@@ -243,6 +246,202 @@ func testLineTable(t *testing.T, want []LineEntry, d *Data) {
 	}
 }
 
+func TestLineTable(t *testing.T) {
+	for _, name := range []string{"testdata/line-gcc.elf", "testdata/line-clang.elf", "testdata/line-inline.elf"} {
+		d := elfData(t, name)
+		lt, err := d.LineTable()
+		if err != nil {
+			t.Fatalf("%s: d.LineTable: %v", name, err)
+		}
+
+		// Collect the line tables of all CUs and check that
+		// every PC they cover is found by the index.
+		covered := make(map[uint64]bool)
+		var ends []uint64
+		for _, table := range allLineTables(t, d) {
+			for i, ent := range table {
+				if ent.EndSequence {
+					ends = append(ends, ent.Address)
+					continue
+				}
+				for pc := ent.Address; pc < table[i+1].Address; pc++ {
+					covered[pc] = true
+					file, line, err := lt.Lookup(pc)
+					if err != nil {
+						t.Fatalf("%s: Lookup(%#x) failed: %v", name, pc, err)
+					}
+					if file.Name != ent.File.Name || line != ent.Line {
+						t.Fatalf("%s: Lookup(%#x) = %s:%d, want %s:%d", name, pc, file.Name, line, ent.File.Name, ent.Line)
+					}
+				}
+			}
+		}
+		for _, pc := range ends {
+			if covered[pc] {
+				continue
+			}
+			if _, _, err := lt.Lookup(pc); err != ErrUnknownPC {
+				t.Errorf("%s: Lookup(%#x) returned %v instead of ErrUnknownPC", name, pc, err)
+			}
+		}
+		if _, _, err := lt.Lookup(0); err != ErrUnknownPC {
+			t.Errorf("%s: Lookup(0) returned %v instead of ErrUnknownPC", name, err)
+		}
+	}
+}
+
+// TestLineTableSeekPC checks that LineTable.Lookup agrees with
+// LineReader.SeekPC where the line table has several rows at the
+// same PC, which gcc emits for inlined calls.
+func TestLineTableSeekPC(t *testing.T) {
+	const name = "testdata/line-inline.elf"
+	d := elfData(t, name)
+	lt, err := d.LineTable()
+	if err != nil {
+		t.Fatalf("d.LineTable: %v", err)
+	}
+
+	var lrs []*LineReader
+	lo, hi := ^uint64(0), uint64(0)
+	samePC := false
+	dr := d.Reader()
+	for {
+		ent, err := dr.Next()
+		if err != nil {
+			t.Fatal("dr.Next:", err)
+		} else if ent == nil {
+			break
+		}
+		if ent.Tag != TagCompileUnit {
+			dr.SkipChildren()
+			continue
+		}
+		lr, err := d.LineReader(ent)
+		if err != nil {
+			t.Fatal("d.LineReader:", err)
+		} else if lr == nil {
+			continue
+		}
+		lrs = append(lrs, lr)
+		var line, prev LineEntry
+		for i := 0; lr.Next(&line) == nil; i++ {
+			if line.Address < lo {
+				lo = line.Address
+			}
+			if line.Address > hi {
+				hi = line.Address
+			}
+			if i > 0 && line.Address == prev.Address {
+				samePC = true
+			}
+			prev = line
+		}
+		lr.Reset()
+	}
+	if !samePC {
+		t.Fatalf("%s has no rows at the same PC", name)
+	}
+
+	for pc := lo; pc <= hi; pc++ {
+		var want LineEntry
+		found := false
+		for _, lr := range lrs {
+			if lr.SeekPC(pc, &want) == nil {
+				found = true
+				break
+			}
+		}
+		file, line, err := lt.Lookup(pc)
+		switch {
+		case !found:
+			if err != ErrUnknownPC {
+				t.Errorf("Lookup(%#x) = %s:%d, %v; SeekPC found no entry", pc, file.Name, line, err)
+			}
+		case err != nil:
+			t.Errorf("Lookup(%#x) failed: %v; SeekPC found %s:%d", pc, err, want.File.Name, want.Line)
+		case file.Name != want.File.Name || line != want.Line:
+			t.Errorf("Lookup(%#x) = %s:%d; SeekPC found %s:%d", pc, file.Name, line, want.File.Name, want.Line)
+		}
+	}
+}
+
+// allLineTables returns the line table of every CU in d.
+func allLineTables(t testing.TB, d *Data) [][]LineEntry {
+	var tables [][]LineEntry
+	dr := d.Reader()
+	for {
+		ent, err := dr.Next()
+		if err != nil {
+			t.Fatal("dr.Next:", err)
+		} else if ent == nil {
+			break
+		}
+		if ent.Tag != TagCompileUnit {
+			dr.SkipChildren()
+			continue
+		}
+		lr, err := d.LineReader(ent)
+		if err != nil {
+			t.Fatal("d.LineReader:", err)
+		} else if lr == nil {
+			continue
+		}
+		var table []LineEntry
+		for {
+			var line LineEntry
+			if err := lr.Next(&line); err != nil {
+				if err == io.EOF {
+					break
+				}
+				t.Fatal("lr.Next:", err)
+			}
+			table = append(table, line)
+		}
+		tables = append(tables, table)
+	}
+	return tables
+}
+
+func BenchmarkLineTable(b *testing.B) {
+	b.Run("gcc", func(b *testing.B) {
+		f, err := elf.Open("testdata/line-gcc.elf")
+		if err != nil {
+			b.Fatal(err)
+		}
+		defer f.Close()
+		benchmarkLineTable(b, f)
+	})
+	// The compiler stands in for a large program.
+	b.Run("compile", func(b *testing.B) {
+		exe := filepath.Join(runtime.GOROOT(), "pkg", "tool", runtime.GOOS+"_"+runtime.GOARCH, "compile")
+		f, err := elf.Open(exe)
+		if err != nil {
+			b.Skip(err)
+		}
+		defer f.Close()
+		benchmarkLineTable(b, f)
+	})
+}
+
+func benchmarkLineTable(b *testing.B, f *elf.File) {
+	d, err := f.DWARF()
+	if err != nil {
+		b.Skip(err)
+	}
+	b.Run("LineReader", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			allLineTables(b, d)
+		}
+	})
+	b.Run("LineTable", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			if _, err := d.LineTable(); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+}
+
 func compareLines(a, b []LineEntry) bool {
 	if len(a) != len(b) {
 		return false
@@ -0,0 +1,223 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+package dwarf
+
+import (
+	"io"
+	"runtime"
+	"sort"
+	"sync"
+)
+
+// A LineTable is a compact index from program counter to source
+// position covering the line tables of every compilation unit in a
+// Data. Unlike LineReader.SeekPC, which scans a single line table
+// sequentially, lookups in a LineTable take time logarithmic in the
+// number of rows.
+//
+// A LineTable retains only the file and line of each row; other
+// LineEntry fields are discarded.
+type LineTable struct {
+	rows  []lineTableRow // sorted by pc
+	files []*LineFile
+}
+
+// A lineTableRow covers the PCs from pc to just before the pc of
+// the following row. A row with file < 0 marks the end of a sequence
+// and covers no source position.
+type lineTableRow struct {
+	pc   uint64
+	file int32 // index into LineTable.files, or -1
+	line int32
+}
+
+// cuLines is the decoded line table of a single compilation unit.
+type cuLines struct {
+	rows  []lineTableRow // file indexes are local to this unit
+	files []*LineFile
+	err   error
+}
+
+// LineTable decodes the line tables of all compilation units in d
+// and returns an index for fast PC lookups. Compilation units are
+// decoded concurrently; the result does not depend on the order in
+// which they complete.
+//
+// Where several rows of a compilation unit start at the same PC, the
+// last one is used, as by LineReader.SeekPC. Where rows from several
+// compilation units start at the same PC, the row from the unit that
+// appears first in the .debug_info section is used.
+func (d *Data) LineTable() (*LineTable, error) {
+	var cus []*Entry
+	r := d.Reader()
+	for {
+		e, err := r.Next()
+		if err != nil {
+			return nil, err
+		}
+		if e == nil {
+			break
+		}
+		if e.Tag == TagCompileUnit {
+			cus = append(cus, e)
+		}
+		r.SkipChildren()
+	}
+
+	units := make([]cuLines, len(cus))
+	work := make(chan int, len(cus))
+	for i := range cus {
+		work <- i
+	}
+	close(work)
+
+	nworker := runtime.GOMAXPROCS(0)
+	if nworker > len(cus) {
+		nworker = len(cus)
+	}
+	var wg sync.WaitGroup
+	wg.Add(nworker)
+	for w := 0; w < nworker; w++ {
+		go func() {
+			defer wg.Done()
+			for i := range work {
+				units[i] = d.decodeCULines(cus[i])
+			}
+		}()
+	}
+	wg.Wait()
+
+	// Merge the per-unit tables, renumbering file indexes into
+	// the combined file list. Units are visited in section order
+	// so the merge is deterministic.
+	t := new(LineTable)
+	n := 0
+	for i := range units {
+		if units[i].err != nil {
+			return nil, units[i].err
+		}
+		n += len(units[i].rows)
+	}
+	rows := make(lineTableRows, 0, n)
+	for i := range units {
+		u := &units[i]
+		base := int32(len(t.files))
+		t.files = append(t.files, u.files...)
+		for _, row := range u.rows {
+			if row.file >= 0 {
+				row.file += base
+			}
+			rows = append(rows, row)
+		}
+	}
+	sort.Stable(rows)
+	t.rows = compactLineTableRows(rows)
+	return t, nil
+}
+
+// decodeCULines reads the line table of compilation unit cu.
+func (d *Data) decodeCULines(cu *Entry) cuLines {
+	var u cuLines
+	lr, err := d.LineReader(cu)
+	if err != nil {
+		u.err = err
+		return u
+	}
+	if lr == nil {
+		return u
+	}
+	fileIndex := make(map[*LineFile]int32)
+	var ent LineEntry
+	for {
+		if err := lr.Next(&ent); err != nil {
+			if err != io.EOF {
+				u.err = err
+			}
+			return u
+		}
+		row := lineTableRow{pc: ent.Address, file: -1}
+		if !ent.EndSequence {
+			fi, ok := fileIndex[ent.File]
+			if !ok {
+				fi = int32(len(u.files))
+				fileIndex[ent.File] = fi
+				u.files = append(u.files, ent.File)
+			}
+			row.file, row.line = fi, int32(ent.Line)
+		}
+		// A row covers no PCs if the next row starts at the same
+		// PC, as happens around inlined calls, so keep only the
+		// last row at a PC, as SeekPC does.
+		if n := len(u.rows); n > 0 && u.rows[n-1].pc == row.pc {
+			u.rows[n-1] = row
+			continue
+		}
+		u.rows = append(u.rows, row)
+	}
+}
+
+// lineTableRows sorts rows by pc. At equal pcs, end-of-sequence rows
+// sort before rows that start a new range, so a sequence that begins
+// where another ends is not hidden by the terminator.
+type lineTableRows []lineTableRow
+
+func (x lineTableRows) Len() int      { return len(x) }
+func (x lineTableRows) Swap(i, j int) { x[i], x[j] = x[j], x[i] }
+func (x lineTableRows) Less(i, j int) bool {
+	if x[i].pc != x[j].pc {
+		return x[i].pc < x[j].pc
+	}
+	return x[i].file < 0 && x[j].file >= 0
+}
+
+// compactLineTableRows reduces each run of rows at the same pc to
+// a single row and drops rows that repeat the position of the row
+// before them. rows must be sorted.
+func compactLineTableRows(rows []lineTableRow) []lineTableRow {
+	out := rows[:0]
+	for i := 0; i < len(rows); {
+		// Keep the first live row at this pc, or a terminator
+		// if there is none.
+		row := rows[i]
+		j := i + 1
+		for ; j < len(rows) && rows[j].pc == row.pc; j++ {
+			if row.file < 0 && rows[j].file >= 0 {
+				row = rows[j]
+			}
+		}
+		i = j
+		if len(out) > 0 {
+			last := out[len(out)-1]
+			if last.file == row.file && last.line == row.line {
+				continue
+			}
+		}
+		out = append(out, row)
+	}
+	return out
+}
+
+// Lookup returns the source file and line of the instruction at pc.
+// If pc is not covered by any line table, Lookup returns
+// ErrUnknownPC.
+func (t *LineTable) Lookup(pc uint64) (file *LineFile, line int, err error) {
+	// Find the first row after pc.
+	i := sort.Search(len(t.rows), func(i int) bool {
+		return t.rows[i].pc > pc
+	})
+	if i == 0 {
+		return nil, 0, ErrUnknownPC
+	}
+	row := &t.rows[i-1]
+	if row.file < 0 {
+		return nil, 0, ErrUnknownPC
+	}
+	return t.files[row.file], int(row.line), nil
+}
+
+// Len returns the number of rows in the table.
+func (t *LineTable) Len() int {
+	return len(t.rows)
+}
@@ -0,0 +1,24 @@
+static inline int
+square(int x)
+{
+	return x * x;
+}
+
+static inline int
+sum(int *a, int n)
+{
+	int i, s;
+
+	s = 0;
+	for (i = 0; i < n; i++)
+		s += square(a[i]);
+	return s;
+}
+
+int
+main(int argc, char **argv)
+{
+	int a[4] = {argc, argc + 1, argc + 2, argc + 3};
+
+	return sum(a, 4) + square(argc);
+}
@@ -44,6 +44,28 @@ type LineTable struct {
 	nfiletab uint32
 	fileMap  map[string]uint32
 	strings  map[uint32]string // interned substrings of Data, keyed by offset
+
+	// pcvalue resumes the scan of a table where the last lookup in it
+	// stopped. Each PCToLine looks in two tables, file and line.
+	cursor     [2]pcvalueCursor
+	nextCursor int // cursor to replace on a miss
+
+	// findFunc's last result, which covers [funcEntry, funcEnd).
+	lastFunc           []byte
+	funcEntry, funcEnd uint64
+}
+
+// A pcvalueCursor records the state of a scan of a pc-value table
+// just before the step that covered the last pc looked up in it.
+// Callers such as disassemblers look up the pcs of a function in
+// increasing order, and resuming there instead of at the function
+// entry makes each of those lookups take constant time.
+type pcvalueCursor struct {
+	off   uint32 // offset of the table
+	entry uint64 // start PC of its function
+	p     []byte // rest of the table, or nil if the cursor is unused
+	pc    uint64
+	val   int32
 }
 
 // NOTE(rsc): This is wrong for GOARCH=arm, which uses a quantum of 4,
@@ -227,6 +249,9 @@ func (t *LineTable) go12Funcs() []Func {
 
 // findFunc returns the func corresponding to the given program counter.
 func (t *LineTable) findFunc(pc uint64) []byte {
+	if t.lastFunc != nil && t.funcEntry <= pc && pc < t.funcEnd {
+		return t.lastFunc
+	}
 	if pc < t.uintptr(t.functab) || pc >= t.uintptr(t.functab[len(t.functab)-int(t.ptrsize):]) {
 		return nil
 	}
@@ -239,7 +264,9 @@ func (t *LineTable) findFunc(pc uint64) []byte {
 		m := nf / 2
 		fm := f[2*t.ptrsize*m:]
 		if t.uintptr(fm) <= pc && pc < t.uintptr(fm[2*t.ptrsize:]) {
-			return t.Data[t.uintptr(fm[t.ptrsize:]):]
+			t.lastFunc = t.Data[t.uintptr(fm[t.ptrsize:]):]
+			t.funcEntry, t.funcEnd = t.uintptr(fm), t.uintptr(fm[2*t.ptrsize:])
+			return t.lastFunc
 		} else if pc < t.uintptr(fm) {
 			nf = m
 		} else {
@@ -303,8 +330,23 @@ func (t *LineTable) pcvalue(off uint32, entry, targetpc uint64) int32 {
 
 	val := int32(-1)
 	pc := entry
-	for t.step(&p, &pc, &val, pc == entry) {
+	c := &t.cursor[0]
+	if c.off != off || c.entry != entry {
+		c = &t.cursor[1]
+	}
+	if c.off == off && c.entry == entry && c.p != nil && c.pc <= targetpc {
+		p, pc, val = c.p, c.pc, c.val
+	} else if c.off != off || c.entry != entry {
+		c = &t.cursor[t.nextCursor]
+		t.nextCursor ^= 1
+	}
+	for {
+		p0, pc0, val0 := p, pc, val
+		if !t.step(&p, &pc, &val, pc == entry) {
+			break
+		}
 		if targetpc < pc {
+			*c = pcvalueCursor{off: off, entry: entry, p: p0, pc: pc0, val: val0}
 			return val
 		}
 	}
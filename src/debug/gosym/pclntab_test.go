@@ -285,3 +285,42 @@ func TestPCLine(t *testing.T) {
 		off = pc + 1 - text.Addr
 	}
 }
+
+// TestPCToLineOrder checks that looking up the pcs of the functions in
+// the test binary in increasing order, which resumes each lookup where
+// the previous one stopped, gives the same answers as looking them up
+// in decreasing order, which does not.
+func TestPCToLineOrder(t *testing.T) {
+	skipIfNotELF(t)
+	fwd, rev := getTable(t), getTable(t)
+	if fwd.go12line == nil {
+		t.Skip("not a Go 1.2 symbol table")
+	}
+	n := 0
+	for i := range fwd.Funcs {
+		fn := &fwd.Funcs[i]
+		if !strings.HasPrefix(fn.Name, "debug/gosym.") && !strings.HasPrefix(fn.Name, "strings.") {
+			continue
+		}
+		type pos struct {
+			file string
+			line int
+		}
+		var want []pos
+		for pc := fn.End - 1; pc >= fn.Entry; pc-- {
+			file, line, _ := rev.PCToLine(pc)
+			want = append(want, pos{file, line})
+		}
+		for pc := fn.Entry; pc < fn.End; pc++ {
+			file, line, _ := fwd.PCToLine(pc)
+			w := want[fn.End-1-pc]
+			if file != w.file || line != w.line {
+				t.Fatalf("PCToLine(%#x) in %s = %s:%d, want %s:%d", pc, fn.Name, file, line, w.file, w.line)
+			}
+			n++
+		}
+	}
+	if n == 0 {
+		t.Fatal("no functions found")
+	}
+}
@@ -1382,8 +1382,13 @@ func (ctxt *Context) saveCgo(filename string, di *Package, cg *ast.CommentGroup)
 			continue
 		}
 
-		// Split at colon.
+		// #cgo blocking and async lines are for cmd/cgo alone.
 		line = strings.TrimSpace(line[4:])
+		if f := strings.Fields(line); len(f) > 0 && (f[0] == "blocking" || f[0] == "async") {
+			continue
+		}
+
+		// Split at colon.
 		i := strings.Index(line, ":")
 		if i < 0 {
 			return fmt.Errorf("%s: invalid #cgo line: %s", filename, orig)
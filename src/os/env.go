@@ -129,6 +129,26 @@ func Unsetenv(key string) error {
 	return syscall.Unsetenv(key)
 }
 
+// UpdateEnv unsets the environment variables named in unset and then
+// sets the variables in set to their values. It is equivalent to
+// calling Unsetenv and Setenv for each, but where C code shares the
+// environment, as with cgo on Unix systems, it updates the C
+// environment in one pass, which is much faster for many variables.
+// If a key or value in set is invalid, UpdateEnv returns an error
+// without changing the environment on Unix systems.
+//
+// With cgo on Unix systems, UpdateEnv rewrites the C environment
+// without holding the C library's environment lock, so C code must not
+// change the environment, as by calling setenv or putenv, while
+// UpdateEnv runs.
+func UpdateEnv(set map[string]string, unset []string) error {
+	err := syscall.UpdateEnv(set, unset)
+	if err != nil {
+		return NewSyscallError("setenv", err)
+	}
+	return nil
+}
+
 // Clearenv deletes all environment variables.
 func Clearenv() {
 	syscall.Clearenv()
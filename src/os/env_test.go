@@ -150,6 +150,39 @@ func TestClearenv(t *testing.T) {
 	}
 }
 
+func TestUpdateEnv(t *testing.T) {
+	const (
+		keep  = "GO_TEST_UPDATEENV_KEEP"
+		unset = "GO_TEST_UPDATEENV_UNSET"
+		reset = "GO_TEST_UPDATEENV_RESET"
+		set   = "GO_TEST_UPDATEENV_SET"
+	)
+	defer Unsetenv(keep)
+	defer Unsetenv(reset)
+	defer Unsetenv(set)
+	Setenv(keep, "keep")
+	Setenv(unset, "unset")
+	Setenv(reset, "old")
+
+	err := UpdateEnv(map[string]string{reset: "new", set: "set"}, []string{unset, reset})
+	if err != nil {
+		t.Fatalf("UpdateEnv: %v", err)
+	}
+	for key, want := range map[string]string{keep: "keep", reset: "new", set: "set"} {
+		if v, ok := LookupEnv(key); !ok || v != want {
+			t.Errorf("LookupEnv(%q) = %q, %v; want %q, true", key, v, ok, want)
+		}
+	}
+	if v, ok := LookupEnv(unset); ok {
+		t.Errorf("UpdateEnv didn't unset $%s, remained with value %q", unset, v)
+	}
+
+	err = UpdateEnv(map[string]string{keep: "changed", "GO=TEST": "bad"}, nil)
+	if err == nil {
+		t.Error("UpdateEnv with invalid key succeeded")
+	}
+}
+
 func TestLookupEnv(t *testing.T) {
 	const smallpox = "SMALLPOX"      // No one has smallpox.
 	value, ok := LookupEnv(smallpox) // Should not exist.
@@ -196,6 +196,13 @@ signal. If, later, Reset is called for that signal, the original
 handling for that signal will be reinstalled, restoring the non-Go
 signal handler if any.
 
+A program whose non-Go code handles a signal itself, particularly at a
+high rate, can call Forward for that signal. That reinstalls the
+original handling for the signal even where the Go runtime would
+otherwise keep its own handler, so that the signal is delivered
+directly to the non-Go handler, on Go threads and non-Go threads
+alike, without first running the Go signal handler.
+
 Go code built without -buildmode=c-archive or -buildmode=c-shared will
 install a signal handler for the asynchronous signals listed above,
 and save any existing signal handler. If a signal is delivered to a
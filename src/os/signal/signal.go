@@ -46,7 +46,8 @@ func (h *handler) clear(sig int) {
 
 // Stop relaying the signals, sigs, to any channels previously registered to
 // receive them and either reset the signal handlers to their original values
-// (action=disableSignal) or ignore the signals (action=ignoreSignal).
+// (action=disableSignal), ignore the signals (action=ignoreSignal), or
+// forward them to the non-Go handlers (action=forwardSignal).
 func cancel(sigs []os.Signal, action func(int)) {
 	handlers.Lock()
 	defer handlers.Unlock()
@@ -86,6 +87,23 @@ func Ignore(sig ...os.Signal) {
 	cancel(sig, ignoreSignal)
 }
 
+// Forward causes the provided signals to bypass Go's signal handling
+// entirely: they are delivered to the signal handler that was installed
+// when the Go runtime started, if any, which then runs without any Go
+// code running first. If there was no such handler, the signals get
+// their default action, which for some is to terminate the program.
+// Forward undoes the effect of any prior calls to Notify for the
+// provided signals, and a later call to Notify or Ignore undoes it.
+// Reset does not undo it: the signals stay forwarded.
+// SIGPROF, and signals that Notify cannot be used for, are not
+// affected. Forward is intended for programs, typically ones that call
+// Go code as a c-archive or c-shared library, whose non-Go code handles
+// some signals at a high rate.
+// If no signals are provided, all incoming signals will be forwarded.
+func Forward(sig ...os.Signal) {
+	cancel(sig, forwardSignal)
+}
+
 // Ignored reports whether sig is currently ignored.
 func Ignored(sig os.Signal) bool {
 	sn := signum(sig)
@@ -60,6 +60,11 @@ func ignoreSignal(sig int) {
 	signal_ignore(uint32(sig))
 }
 
+// There are no non-Go note handlers to forward to.
+func forwardSignal(sig int) {
+	disableSignal(sig)
+}
+
 func signalIgnored(sig int) bool {
 	return signal_ignored(uint32(sig))
 }
@@ -213,6 +213,36 @@ func TestIgnored(t *testing.T) {
 	Reset()
 }
 
+// Test that Forward sends a signal past the Go handler to its default
+// action, and that Notify undoes it.
+func TestForward(t *testing.T) {
+	c := make(chan os.Signal, 1)
+	Notify(c, syscall.SIGURG)
+	defer Stop(c)
+
+	// SIGURG had no handler when the program started, so its
+	// default action, which is to ignore it, now applies. No other
+	// test uses SIGURG, which could have changed that.
+	Forward(syscall.SIGURG)
+	if Ignored(syscall.SIGURG) {
+		t.Errorf("expected SIGURG to not be ignored when forwarded.")
+	}
+	syscall.Kill(syscall.Getpid(), syscall.SIGURG)
+	select {
+	case s := <-c:
+		t.Fatalf("unexpected signal %v", s)
+	case <-time.After(100 * time.Millisecond):
+		// nothing to read - good
+	}
+
+	// Notify undoes Forward.
+	Notify(c, syscall.SIGURG)
+	syscall.Kill(syscall.Getpid(), syscall.SIGURG)
+	waitSig(t, c, syscall.SIGURG)
+
+	Reset()
+}
+
 var checkSighupIgnored = flag.Bool("check_sighup_ignored", false, "if true, TestDetectNohup will fail if SIGHUP is not ignored.")
 
 // Test that Ignored(SIGHUP) correctly detects whether it is being run under nohup.
@@ -14,6 +14,7 @@ import (
 // Defined by the runtime package.
 func signal_disable(uint32)
 func signal_enable(uint32)
+func signal_forward(uint32)
 func signal_ignore(uint32)
 func signal_ignored(uint32) bool
 func signal_recv() uint32
@@ -58,6 +59,10 @@ func ignoreSignal(sig int) {
 	signal_ignore(uint32(sig))
 }
 
+func forwardSignal(sig int) {
+	signal_forward(uint32(sig))
+}
+
 func signalIgnored(sig int) bool {
 	return signal_ignored(uint32(sig))
 }
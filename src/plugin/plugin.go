@@ -17,12 +17,21 @@
 // Please report any issues.
 package plugin
 
+import "sync"
+
 // Plugin is a loaded Go plugin.
 type Plugin struct {
 	pluginpath string
 	err        string        // set if plugin failed to load
 	loaded     chan struct{} // closed when loaded
-	syms       map[string]interface{}
+	handle     uintptr       // dlopen handle
+
+	mu   sync.Mutex
+	syms map[string]interface{} // symbols resolved by Lookup so far
+	// unresolved holds the symbols as reported by the runtime:
+	// typed but without a value. Function names are prefixed
+	// with '.'.
+	unresolved map[string]interface{}
 }
 
 // Open opens a Go plugin.
@@ -98,6 +98,9 @@ func open(name string) (*Plugin, error) {
 	p := &Plugin{
 		pluginpath: pluginpath,
 		loaded:     make(chan struct{}),
+		handle:     uintptr(h),
+		syms:       make(map[string]interface{}),
+		unresolved: syms,
 	}
 	plugins[filepath] = p
 	pluginsMu.Unlock()
@@ -113,44 +116,45 @@ func open(name string) (*Plugin, error) {
 		initFunc()
 	}
 
-	// Fill out the value of each plugin symbol.
-	updatedSyms := map[string]interface{}{}
-	for symName, sym := range syms {
-		isFunc := symName[0] == '.'
-		if isFunc {
-			delete(syms, symName)
-			symName = symName[1:]
-		}
-
-		fullName := pluginpath + "." + symName
-		cname := make([]byte, len(fullName)+1)
-		copy(cname, fullName)
-
-		p := C.pluginLookup(h, (*C.char)(unsafe.Pointer(&cname[0])), &cErr)
-		if p == nil {
-			return nil, errors.New(`plugin.Open("` + name + `"): could not find symbol ` + symName + `: ` + C.GoString(cErr))
-		}
-		valp := (*[2]unsafe.Pointer)(unsafe.Pointer(&sym))
-		if isFunc {
-			(*valp)[1] = unsafe.Pointer(&p)
-		} else {
-			(*valp)[1] = p
-		}
-		// we can't add to syms during iteration as we'll end up processing
-		// some symbols twice with the inability to tell if the symbol is a function
-		updatedSyms[symName] = sym
-	}
-	p.syms = updatedSyms
-
+	// Symbol values are filled in by lookup on first use, so
+	// that opening a plugin does not cost a dlsym per exported
+	// symbol.
 	close(p.loaded)
 	return p, nil
 }
 
 func lookup(p *Plugin, symName string) (Symbol, error) {
+	p.mu.Lock()
+	defer p.mu.Unlock()
 	if s := p.syms[symName]; s != nil {
 		return s, nil
 	}
-	return nil, errors.New("plugin: symbol " + symName + " not found in plugin " + p.pluginpath)
+
+	sym, isFunc := p.unresolved[symName], false
+	if sym == nil {
+		sym, isFunc = p.unresolved["."+symName], true
+	}
+	if sym == nil {
+		return nil, errors.New("plugin: symbol " + symName + " not found in plugin " + p.pluginpath)
+	}
+
+	fullName := p.pluginpath + "." + symName
+	cname := make([]byte, len(fullName)+1)
+	copy(cname, fullName)
+
+	var cErr *C.char
+	ptr := C.pluginLookup(C.uintptr_t(p.handle), (*C.char)(unsafe.Pointer(&cname[0])), &cErr)
+	if ptr == nil {
+		return nil, errors.New("plugin: could not find symbol " + symName + " in plugin " + p.pluginpath + ": " + C.GoString(cErr))
+	}
+	valp := (*[2]unsafe.Pointer)(unsafe.Pointer(&sym))
+	if isFunc {
+		(*valp)[1] = unsafe.Pointer(&ptr)
+	} else {
+		(*valp)[1] = ptr
+	}
+	p.syms[symName] = sym
+	return sym, nil
 }
 
 var (
@@ -0,0 +1,791 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// This file implements a lazily constructed DFA for searching byte
+// slices and strings. It answers whether a regexp matches and where the
+// leftmost match begins and ends; submatches are left to the other
+// engines.
+//
+// A DFA state is the list of NFA instructions the Pike VM in exec.go
+// would have on its run queue, kept in priority order, so that cutting
+// lower-priority threads at a match gives the same leftmost-first
+// results. States and transitions are built as the input demands them
+// and cached. The cache is bounded by dfaMaxMem; when it fills it is
+// flushed, and a search that flushes it too often gives up so the
+// caller can fall back to the NFA.
+//
+// The forward scan finds where the match ends. The match start is then
+// found by running the reversed program backward from the end, looking
+// for the longest match. See https://swtch.com/~rsc/regexp/regexp3.html
+// for the approach.
+
+package regexp
+
+import (
+	"bytes"
+	"io"
+	"regexp/syntax"
+	"sort"
+	"strings"
+	"unicode"
+	"unicode/utf8"
+)
+
+const (
+	dfaMaxMem           = 1 << 20 // approximate memory budget of a dfa's state cache
+	dfaMinStates        = 64      // a dfa must be able to hold at least this many states
+	dfaStateOverhead    = 64      // approximate fixed cost of a cached state
+	dfaMinBytesPerState = 10      // give up if a flushed cache fills faster than this
+	dfaMinSubmatchLen   = 256     // shorter inputs go straight to the submatch engines
+)
+
+// Flag bits of a dfaState. The low bits record the kind of the rune
+// last consumed, which is all the empty-width operators need to know
+// about it.
+const (
+	dfaKindText    = iota // no rune: beginning or end of text
+	dfaKindNewline        // '\n'
+	dfaKindWord           // a word character, as in \b
+	dfaKindOther          // any other rune
+	dfaKindMask    = 3
+
+	dfaStart = 1 << 2 // start a new thread at the next position
+	dfaMatch = 1 << 3 // a match ended just before the last rune consumed
+)
+
+// dfaKindRune gives a representative rune for each rune kind.
+var dfaKindRune = [...]rune{endOfText, '\n', 'a', ' '}
+
+func dfaKind(r rune) uint8 {
+	switch {
+	case r == endOfText:
+		return dfaKindText
+	case r == '\n':
+		return dfaKindNewline
+	case syntax.IsWordChar(r):
+		return dfaKindWord
+	}
+	return dfaKindOther
+}
+
+// A dfaState is a state of a dfa.
+type dfaState struct {
+	insts []uint32    // instructions to resume, in priority order
+	flag  uint8       // dfaKind* | dfaStart | dfaMatch
+	next  []*dfaState // transitions by rune class; nil if not yet computed
+	stop  bool        // forward must not pass s in its fast path
+}
+
+// dead reports whether no match can be found after s.
+func (s *dfaState) dead() bool {
+	return len(s.insts) == 0 && s.flag&dfaStart == 0
+}
+
+// idle reports whether s is only waiting for a match to start.
+func (s *dfaState) idle() bool {
+	return len(s.insts) == 0 && s.flag&dfaStart != 0
+}
+
+// runeClasses partitions the runes into classes that no instruction of
+// a program can tell apart, so that a dfa needs one transition per
+// class rather than one per rune.
+type runeClasses struct {
+	ascii  [utf8.RuneSelf]uint16 // class of each ASCII rune
+	bounds []rune                // first rune of classes 1 through n-1
+	n      int                   // number of rune classes; class n is endOfText
+}
+
+// newRuneClasses returns the rune classes of p, or nil if there are
+// too many of them for a dfa to be worthwhile.
+func newRuneClasses(p *syntax.Prog) *runeClasses {
+	var b []rune
+	add := func(lo, hi rune) {
+		b = append(b, lo, hi+1)
+	}
+	for pc := range p.Inst {
+		i := &p.Inst[pc]
+		switch i.Op {
+		case syntax.InstRune:
+			if len(i.Rune) == 1 {
+				// A literal, possibly case-folded; see MatchRunePos.
+				r0 := i.Rune[0]
+				add(r0, r0)
+				if syntax.Flags(i.Arg)&syntax.FoldCase != 0 {
+					for r1 := unicode.SimpleFold(r0); r1 != r0; r1 = unicode.SimpleFold(r1) {
+						add(r1, r1)
+					}
+				}
+				break
+			}
+			for j := 0; j+1 < len(i.Rune); j += 2 {
+				add(i.Rune[j], i.Rune[j+1])
+			}
+		case syntax.InstRune1:
+			add(i.Rune[0], i.Rune[0])
+		case syntax.InstRuneAnyNotNL:
+			add('\n', '\n')
+		case syntax.InstEmptyWidth:
+			// Runes of different kinds must not share a class.
+			add('\n', '\n')
+			add('0', '9')
+			add('A', 'Z')
+			add('_', '_')
+			add('a', 'z')
+		}
+	}
+	sort.Slice(b, func(i, j int) bool { return b[i] < b[j] })
+	c := new(runeClasses)
+	for _, r := range b {
+		if r > 0 && (len(c.bounds) == 0 || c.bounds[len(c.bounds)-1] != r) {
+			c.bounds = append(c.bounds, r)
+		}
+	}
+	c.n = len(c.bounds) + 1
+	if (c.n+1)*8*dfaMinStates > dfaMaxMem {
+		return nil
+	}
+	for r := range c.ascii {
+		c.ascii[r] = uint16(c.search(rune(r)))
+	}
+	return c
+}
+
+// search returns the class of r by binary search.
+func (c *runeClasses) search(r rune) int {
+	lo, hi := 0, len(c.bounds)
+	for lo < hi {
+		m := int(uint(lo+hi) >> 1)
+		if c.bounds[m] <= r {
+			lo = m + 1
+		} else {
+			hi = m
+		}
+	}
+	return lo
+}
+
+// A dfa is a lazily built DFA running a program over a byte slice or
+// string. It is not safe for concurrent use; each machine has its own.
+type dfa struct {
+	prog     *syntax.Prog
+	classes  *runeClasses
+	longest  bool // keep going after a match, to find the longest one
+	anchored bool // start a thread only at the initial position
+	reverse  bool // scan backward; see reverseProg
+	flags    bool // prog has empty-width instructions
+	skip     bool // idle states search for the regexp's literal prefix or start literals
+
+	// For a Set: the pattern each instruction belongs to, or nil.
+	// Match instructions stay in every state after the one that
+	// reached them, so the final state lists all patterns that matched.
+	pattern  []int32
+	npattern int
+	done     []bool // scratch: patterns known to match in follow
+	maxMem   int    // budget of cache
+
+	cache   map[string]*dfaState
+	mem     int                        // approximate size of cache
+	starts  [dfaKindMask + 1]*dfaState // start states, by kind of preceding rune
+	resetAt int                        // position of last cache flush in this search, or -1
+	litNext []int                      // for prefilter.indexStart
+
+	// scratch space for computing transitions
+	q      queue    // instructions visited by add
+	seen   queue    // instructions already added to next
+	leaves []uint32 // instructions that match or consume a rune, by priority
+	stack  []uint32
+	next   []uint32
+	key    []byte
+}
+
+func newDFA(prog *syntax.Prog, classes *runeClasses, longest, anchored, reverse bool) *dfa {
+	d := &dfa{
+		prog:     prog,
+		classes:  classes,
+		longest:  longest,
+		anchored: anchored,
+		reverse:  reverse,
+		maxMem:   dfaMaxMem,
+	}
+	for pc := range prog.Inst {
+		if prog.Inst[pc].Op == syntax.InstEmptyWidth {
+			d.flags = true
+			break
+		}
+	}
+	n := len(prog.Inst)
+	d.q = queue{make([]uint32, n), make([]entry, 0, n)}
+	d.seen = queue{make([]uint32, n), make([]entry, 0, n)}
+	d.reset()
+	return d
+}
+
+// reset empties the state cache.
+func (d *dfa) reset() {
+	d.cache = make(map[string]*dfaState)
+	d.mem = 0
+	d.starts = [dfaKindMask + 1]*dfaState{}
+}
+
+// intern returns the cached state with the given instructions and flag,
+// adding it to the cache if necessary. It returns nil if the cache is full.
+func (d *dfa) intern(insts []uint32, flag uint8) *dfaState {
+	k := append(d.key[:0], flag)
+	for _, pc := range insts {
+		k = append(k, byte(pc), byte(pc>>8), byte(pc>>16), byte(pc>>24))
+	}
+	d.key = k
+	if s, ok := d.cache[string(k)]; ok {
+		return s
+	}
+	cost := dfaStateOverhead + 2*len(k) + 8*(d.classes.n+1)
+	if d.mem+cost > d.maxMem {
+		return nil
+	}
+	d.mem += cost
+	s := &dfaState{
+		insts: append([]uint32(nil), insts...),
+		flag:  flag,
+		next:  make([]*dfaState, d.classes.n+1),
+	}
+	if d.pattern != nil {
+		s.stop = d.matches(s.insts) == d.npattern
+	} else {
+		s.stop = flag&dfaMatch != 0 || s.dead() || d.skip && s.idle()
+	}
+	d.cache[string(k)] = s
+	return s
+}
+
+// start returns the state at the beginning of a search, where the rune
+// preceding the search (in scan order) has the given kind.
+func (d *dfa) start(kind uint8) *dfaState {
+	if !d.flags {
+		kind = dfaKindText
+	}
+	s := d.starts[kind]
+	if s == nil {
+		if s = d.intern(nil, kind|dfaStart); s == nil {
+			d.reset()
+			s = d.intern(nil, kind|dfaStart)
+		}
+		d.starts[kind] = s
+	}
+	return s
+}
+
+// add adds pc and the instructions reachable from it by empty-width
+// transitions allowed by cond to d.q, recording the instructions that
+// match or consume a rune in d.leaves. The order is the one the Pike VM
+// gives its threads.
+func (d *dfa) add(pc uint32, cond syntax.EmptyOp) {
+	stk := append(d.stack[:0], pc)
+	for len(stk) > 0 {
+		pc := stk[len(stk)-1]
+		stk = stk[:len(stk)-1]
+		if j := d.q.sparse[pc]; j < uint32(len(d.q.dense)) && d.q.dense[j].pc == pc {
+			continue
+		}
+		d.q.sparse[pc] = uint32(len(d.q.dense))
+		d.q.dense = append(d.q.dense, entry{pc: pc})
+
+		i := &d.prog.Inst[pc]
+		switch i.Op {
+		default:
+			panic("unhandled")
+		case syntax.InstFail:
+			// nothing
+		case syntax.InstAlt, syntax.InstAltMatch:
+			stk = append(stk, i.Arg, i.Out)
+		case syntax.InstEmptyWidth:
+			if syntax.EmptyOp(i.Arg)&^cond == 0 {
+				stk = append(stk, i.Out)
+			}
+		case syntax.InstNop, syntax.InstCapture:
+			stk = append(stk, i.Out)
+		case syntax.InstMatch, syntax.InstRune, syntax.InstRune1, syntax.InstRuneAny, syntax.InstRuneAnyNotNL:
+			d.leaves = append(d.leaves, pc)
+		}
+	}
+	d.stack = stk
+}
+
+// step computes the transition from s on rune r, of class c, and caches
+// it in s. It returns nil if the cache is full.
+func (d *dfa) step(s *dfaState, r rune, c int) *dfaState {
+	next, flag := d.follow(s.insts, s.flag, r)
+	ns := d.intern(next, flag)
+	if ns != nil {
+		s.next[c] = ns
+	}
+	return ns
+}
+
+// follow returns the instructions and flag of the state that follows
+// the one with the given instructions and flag on rune r. The returned
+// slice is overwritten by the next call.
+func (d *dfa) follow(insts []uint32, sflag uint8, r rune) ([]uint32, uint8) {
+	var cond syntax.EmptyOp
+	if d.flags {
+		prev := dfaKindRune[sflag&dfaKindMask]
+		if d.reverse {
+			cond = syntax.EmptyOpContext(r, prev)
+		} else {
+			cond = syntax.EmptyOpContext(prev, r)
+		}
+	}
+	d.q.dense = d.q.dense[:0]
+	d.leaves = d.leaves[:0]
+	for _, pc := range insts {
+		d.add(pc, cond)
+	}
+	var flag uint8
+	if sflag&dfaStart != 0 {
+		d.add(uint32(d.prog.Start), cond)
+		if !d.anchored {
+			flag = dfaStart
+		}
+	}
+	if d.flags {
+		flag |= dfaKind(r)
+	}
+
+	d.seen.dense = d.seen.dense[:0]
+	next := d.next[:0]
+	matched := false
+Leaves:
+	for _, pc := range d.leaves {
+		i := &d.prog.Inst[pc]
+		add := false
+		out := i.Out
+		switch i.Op {
+		case syntax.InstMatch:
+			if d.pattern != nil {
+				// Keep the match in the next state; see Set.
+				d.done[d.pattern[pc]] = true
+				matched = true
+				add, out = true, pc
+				break
+			}
+			flag |= dfaMatch
+			flag &^= dfaStart
+			if !d.longest {
+				// First-match mode: cut off all lower-priority threads.
+				break Leaves
+			}
+		case syntax.InstRune:
+			add = r != endOfText && i.MatchRune(r)
+		case syntax.InstRune1:
+			add = r == i.Rune[0]
+		case syntax.InstRuneAny:
+			add = r != endOfText
+		case syntax.InstRuneAnyNotNL:
+			add = r != endOfText && r != '\n'
+		}
+		if !add {
+			continue
+		}
+		if j := d.seen.sparse[out]; j < uint32(len(d.seen.dense)) && d.seen.dense[j].pc == out {
+			continue
+		}
+		d.seen.sparse[out] = uint32(len(d.seen.dense))
+		d.seen.dense = append(d.seen.dense, entry{pc: out})
+		next = append(next, out)
+	}
+	if d.pattern != nil {
+		next = d.pruneSet(next, matched)
+	}
+	d.next = next
+	return next, flag
+}
+
+// transition returns the state following s on rune r, of class c,
+// consumed at position p. If the cache is full it is flushed, unless
+// that has happened too recently in this search, in which case
+// transition returns nil and the search should be abandoned.
+func (d *dfa) transition(s *dfaState, r rune, c, p int) *dfaState {
+	if ns := d.step(s, r, c); ns != nil {
+		return ns
+	}
+	if d.resetAt >= 0 {
+		progress := p - d.resetAt
+		if progress < 0 {
+			progress = -progress
+		}
+		if progress < dfaMinBytesPerState*len(d.cache) {
+			return nil
+		}
+	}
+	d.resetAt = p
+	d.reset()
+	if s = d.intern(s.insts, s.flag); s == nil {
+		return nil
+	}
+	return d.step(s, r, c)
+}
+
+// forward runs d over the input from pos to its end and returns the
+// position at which the last match found ends, or -1 if there is none.
+// If earliest is set, it stops at the first match instead. It reports
+// ok = false if it gave up.
+func (d *dfa) forward(re *Regexp, b []byte, s string, pos int, earliest bool) (end int, ok bool) {
+	n := len(s)
+	if b != nil {
+		n = len(b)
+	}
+	d.resetAt = -1
+	for i := range d.litNext {
+		d.litNext[i] = -2
+	}
+	end = -1
+	st := d.start(d.kindBefore(b, s, pos))
+	for p := pos; ; {
+		if d.skip && st.idle() {
+			// Match requires a literal prefix or one of the
+			// prefilter's start literals; fast search for it.
+			q := -1
+			if re.prefix != "" {
+				if b != nil {
+					q = bytes.Index(b[p:], re.prefixBytes)
+				} else {
+					q = strings.Index(s[p:], re.prefix)
+				}
+				if q >= 0 {
+					q += p
+				}
+			} else {
+				q = re.prefilter.indexStart(b, s, p, d.litNext)
+			}
+			if q < 0 {
+				return end, true
+			}
+			if q > p {
+				p = q
+				st = d.start(d.kindBefore(b, s, p))
+			}
+		}
+		// Fast path: run over ASCII text while no state needs attention.
+		if b != nil {
+			for p < n && b[p] < utf8.RuneSelf {
+				ns := st.next[d.classes.ascii[b[p]]]
+				if ns == nil || ns.stop {
+					break
+				}
+				st = ns
+				p++
+			}
+		} else {
+			for p < n && s[p] < utf8.RuneSelf {
+				ns := st.next[d.classes.ascii[s[p]]]
+				if ns == nil || ns.stop {
+					break
+				}
+				st = ns
+				p++
+			}
+		}
+		r, w, c := endOfText, 0, d.classes.n
+		if p < n {
+			var ch byte
+			if b != nil {
+				ch = b[p]
+			} else {
+				ch = s[p]
+			}
+			if ch < utf8.RuneSelf {
+				r, w, c = rune(ch), 1, int(d.classes.ascii[ch])
+			} else {
+				if b != nil {
+					r, w = utf8.DecodeRune(b[p:])
+				} else {
+					r, w = utf8.DecodeRuneInString(s[p:])
+				}
+				c = d.classes.search(r)
+			}
+		}
+		ns := st.next[c]
+		if ns == nil {
+			if ns = d.transition(st, r, c, p); ns == nil {
+				return -1, false
+			}
+		}
+		if ns.flag&dfaMatch != 0 {
+			end = p
+			if earliest {
+				return end, true
+			}
+		}
+		if w == 0 || ns.dead() {
+			return end, true
+		}
+		st = ns
+		p += w
+	}
+}
+
+// backward runs d backward over the input from end down to pos and
+// returns the smallest position at which a match was found, or -1.
+// It reports ok = false if it gave up.
+func (d *dfa) backward(b []byte, s string, pos, end int) (start int, ok bool) {
+	d.resetAt = -1
+	start = -1
+	kind := uint8(dfaKindText)
+	if b != nil && end < len(b) {
+		r, _ := utf8.DecodeRune(b[end:])
+		kind = dfaKind(r)
+	} else if b == nil && end < len(s) {
+		r, _ := utf8.DecodeRuneInString(s[end:])
+		kind = dfaKind(r)
+	}
+	st := d.start(kind)
+	for p := end; ; {
+		r, w, c := endOfText, 0, d.classes.n
+		if p > 0 {
+			var ch byte
+			if b != nil {
+				ch = b[p-1]
+			} else {
+				ch = s[p-1]
+			}
+			if ch < utf8.RuneSelf {
+				r, w, c = rune(ch), 1, int(d.classes.ascii[ch])
+			} else {
+				if b != nil {
+					r, w = utf8.DecodeLastRune(b[:p])
+				} else {
+					r, w = utf8.DecodeLastRuneInString(s[:p])
+				}
+				if p > pos && (r == utf8.RuneError && w == 1 || p-w < pos) {
+					// Invalid UTF-8 or a rune straddling pos:
+					// decoding backward might not split the text
+					// into the runes the forward scan saw.
+					return -1, false
+				}
+				c = d.classes.search(r)
+			}
+		}
+		ns := st.next[c]
+		if ns == nil {
+			if ns = d.transition(st, r, c, p); ns == nil {
+				return -1, false
+			}
+		}
+		if ns.flag&dfaMatch != 0 {
+			start = p
+		}
+		if p == pos || ns.dead() {
+			return start, true
+		}
+		st = ns
+		p -= w
+	}
+}
+
+// pruneSet drops from next, the instructions of a Set's dfa state, the
+// threads of patterns that have already matched, whose match
+// instructions next holds, and sorts the rest. Priority means nothing
+// to a Set, and sorting lets states that differ only in thread order
+// share a cache entry. matched reports whether d.done has marks to
+// clear.
+func (d *dfa) pruneSet(next []uint32, matched bool) []uint32 {
+	if matched {
+		keep := next[:0]
+		for _, pc := range next {
+			if d.prog.Inst[pc].Op == syntax.InstMatch || !d.done[d.pattern[pc]] {
+				keep = append(keep, pc)
+			}
+		}
+		next = keep
+		for _, pc := range next {
+			d.done[d.pattern[pc]] = false
+		}
+	}
+	sort.Slice(next, func(i, j int) bool { return next[i] < next[j] })
+	return next
+}
+
+// matches returns the number of patterns of a Set that have matched by
+// the state with the given instructions.
+func (d *dfa) matches(insts []uint32) int {
+	n := 0
+	for _, pc := range insts {
+		if d.prog.Inst[pc].Op == syntax.InstMatch {
+			n++
+		}
+	}
+	return n
+}
+
+// kindBefore returns the kind of the rune before pos in the input.
+func (d *dfa) kindBefore(b []byte, s string, pos int) uint8 {
+	if !d.flags || pos == 0 {
+		return dfaKindText
+	}
+	var r rune
+	if b != nil {
+		r, _ = utf8.DecodeLastRune(b[:pos])
+	} else {
+		r, _ = utf8.DecodeLastRuneInString(s[:pos])
+	}
+	return dfaKind(r)
+}
+
+// reverseProg returns a program matching the reversal of each string
+// matched by p, running p's edges backward. Empty-width instructions
+// are copied unchanged, so a dfa running the result must evaluate them
+// in the orientation of the original text; dfa.step does that when
+// dfa.reverse is set. The result is only suitable for a dfa: it has no
+// captures and its alternations have no meaningful priority.
+func reverseProg(p *syntax.Prog) *syntax.Prog {
+	n := len(p.Inst)
+	preds := make([][]uint32, n)
+	var matches []uint32
+	for pc := range p.Inst {
+		i := &p.Inst[pc]
+		switch i.Op {
+		case syntax.InstFail:
+			// nothing
+		case syntax.InstMatch:
+			matches = append(matches, uint32(pc))
+		case syntax.InstAlt, syntax.InstAltMatch:
+			preds[i.Out] = append(preds[i.Out], uint32(pc))
+			preds[i.Arg] = append(preds[i.Arg], uint32(pc))
+		default:
+			preds[i.Out] = append(preds[i.Out], uint32(pc))
+		}
+	}
+
+	// Instruction pc of the result stands for the point just before
+	// instruction pc of p. Instruction n+pc repeats the rune or
+	// empty-width test of instruction pc of p, then moves to pc.
+	inst := make([]syntax.Inst, 2*n+1, 3*n)
+	matchPC := uint32(2 * n)
+	inst[matchPC].Op = syntax.InstMatch
+	edge := func(pc uint32) uint32 {
+		switch p.Inst[pc].Op {
+		case syntax.InstAlt, syntax.InstAltMatch, syntax.InstNop, syntax.InstCapture:
+			return pc
+		}
+		return uint32(n) + pc
+	}
+	// fanout makes instruction pc continue at each of targets.
+	fanout := func(pc uint32, targets []uint32) {
+		for len(targets) > 1 {
+			alt := uint32(len(inst))
+			inst = append(inst, syntax.Inst{})
+			inst[pc] = syntax.Inst{Op: syntax.InstAlt, Out: targets[0], Arg: alt}
+			pc, targets = alt, targets[1:]
+		}
+		if len(targets) == 0 {
+			inst[pc] = syntax.Inst{Op: syntax.InstFail}
+			return
+		}
+		inst[pc] = syntax.Inst{Op: syntax.InstNop, Out: targets[0]}
+	}
+
+	var targets []uint32
+	for pc := 0; pc < n; pc++ {
+		i := &p.Inst[pc]
+		switch i.Op {
+		case syntax.InstRune, syntax.InstRune1, syntax.InstRuneAny, syntax.InstRuneAnyNotNL, syntax.InstEmptyWidth:
+			inst[n+pc] = syntax.Inst{Op: i.Op, Out: uint32(pc), Arg: i.Arg, Rune: i.Rune}
+		default:
+			inst[n+pc] = syntax.Inst{Op: syntax.InstFail}
+		}
+		if pc == 0 {
+			// Fail; never reached.
+			inst[0] = syntax.Inst{Op: syntax.InstFail}
+			continue
+		}
+		targets = targets[:0]
+		for _, pred := range preds[pc] {
+			targets = append(targets, edge(pred))
+		}
+		if pc == p.Start {
+			targets = append(targets, matchPC)
+		}
+		fanout(uint32(pc), targets)
+	}
+	start := uint32(len(inst))
+	inst = append(inst, syntax.Inst{})
+	fanout(start, matches)
+	return &syntax.Prog{Inst: inst, Start: int(start)}
+}
+
+// A dfaSet holds the dfas a machine uses to search byte slices and
+// strings. They are allocated on first use.
+type dfaSet struct {
+	disabled bool // program cannot use a dfa
+	classes  *runeClasses
+	fwd      *dfa // leftmost-first, to find where a match ends
+	rev      *dfa // reversed program, to find where it begins
+	longest  *dfa // anchored leftmost-longest, to extend a match
+}
+
+// dfaExecute runs the search of doExecute using the machine's dfas.
+// It handles only byte slices and strings, and reports ok = false if
+// the search must be done by another engine instead. On a match,
+// m.matchcap[0:2] holds its position if ncap >= 2. The dfas cannot
+// find submatches: if ncap > 2, the caller must run another engine,
+// which can start at m.matchcap[0]. On short inputs that is no faster
+// than running the other engine alone, so dfaExecute declines them.
+func (m *machine) dfaExecute(r io.RuneReader, b []byte, s string, pos, ncap int) (matched, ok bool) {
+	if r != nil || m.dfa.disabled {
+		return false, false
+	}
+	if ncap > 2 && len(b)+len(s)-pos < dfaMinSubmatchLen {
+		return false, false
+	}
+	re := m.re
+	startCond := re.cond
+	if startCond == ^syntax.EmptyOp(0) { // impossible
+		return false, true
+	}
+	if startCond&syntax.EmptyBeginText != 0 && pos != 0 {
+		// Anchored match, past beginning of text.
+		return false, true
+	}
+	ds := &m.dfa
+	if ds.fwd == nil {
+		if ds.classes = newRuneClasses(m.p); ds.classes == nil {
+			ds.disabled = true
+			return false, false
+		}
+		anchored := startCond&syntax.EmptyBeginText != 0
+		ds.fwd = newDFA(m.p, ds.classes, false, anchored, false)
+		if !anchored && re.prefix != "" {
+			ds.fwd.skip = true
+		} else if f := re.prefilter; !anchored && f != nil && f.starts != nil {
+			ds.fwd.skip = true
+			ds.fwd.litNext = make([]int, len(f.starts))
+		}
+	}
+	end, ok := ds.fwd.forward(re, b, s, pos, ncap == 0)
+	if !ok || end < 0 {
+		return false, ok
+	}
+	m.matchcap = m.matchcap[:ncap]
+	if ncap == 0 {
+		return true, true
+	}
+
+	if ds.rev == nil {
+		ds.rev = newDFA(reverseProg(m.p), ds.classes, true, true, true)
+	}
+	start, ok := ds.rev.backward(b, s, pos, end)
+	if !ok || start < 0 {
+		return false, false
+	}
+	if re.longest && ncap == 2 {
+		if ds.longest == nil {
+			ds.longest = newDFA(m.p, ds.classes, true, true, false)
+		}
+		if end, ok = ds.longest.forward(re, b, s, start, false); !ok || end < 0 {
+			return false, false
+		}
+	}
+	m.matchcap[0] = start
+	m.matchcap[1] = end
+	return true, true
+}
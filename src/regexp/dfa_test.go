@@ -0,0 +1,179 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+package regexp
+
+import (
+	"bufio"
+	"io"
+	"os"
+	"path/filepath"
+	"strings"
+	"testing"
+	"unicode/utf8"
+)
+
+// nfaIndex returns the leftmost match of re in s at or after pos,
+// as found by the NFA.
+func nfaIndex(re *Regexp, s string, pos int) []int {
+	m := progMachine(re.prog, notOnePass)
+	m.re = re
+	m.init(2)
+	if !m.match(m.newInputString(s), pos) {
+		return nil
+	}
+	return m.matchcap
+}
+
+// dfaIndex is like nfaIndex but uses the DFA, and reports whether the
+// DFA could handle the search.
+func dfaIndex(re *Regexp, s string, pos int) (loc []int, ok bool) {
+	m := progMachine(re.prog, notOnePass)
+	m.re = re
+	matched, ok := m.dfaExecute(nil, nil, s, pos, 2)
+	if !matched {
+		return nil, ok
+	}
+	return m.matchcap, ok
+}
+
+func testDFA(t *testing.T, re *Regexp, s string, mustRun bool) {
+	for pos := 0; pos <= len(s); pos++ {
+		want := nfaIndex(re, s, pos)
+		have, ok := dfaIndex(re, s, pos)
+		if !ok {
+			// The DFA leaves searches that start inside a rune to the NFA.
+			if mustRun && utf8.ValidString(s[pos:]) {
+				t.Errorf("%#q at %d in %#q: DFA gave up", re, pos, s)
+			}
+			continue
+		}
+		if !same(have, want) {
+			t.Errorf("%#q at %d in %#q: DFA found %v, NFA found %v", re, pos, s, have, want)
+		}
+	}
+}
+
+func TestDFA(t *testing.T) {
+	for _, test := range findTests {
+		re := MustCompile(test.pat)
+		testDFA(t, re, test.text, true)
+		re.Longest()
+		testDFA(t, re, test.text, true)
+	}
+}
+
+func TestDFACacheFlush(t *testing.T) {
+	// The DFA for this regexp needs a state for every 16-letter
+	// suffix of the input, more than fit in the cache.
+	re := MustCompile(`(a|b)*a(a|b){15}c`)
+	text := make([]byte, 1<<16)
+	x := uint32(1)
+	for i := range text {
+		x = x*1664525 + 1013904223
+		text[i] = 'a' + byte(x>>31)
+	}
+	s := string(text) + "c"
+	for _, pos := range []int{0, len(s) / 2, len(s) - 20} {
+		want := nfaIndex(re, s, pos)
+		if have, ok := dfaIndex(re, s, pos); ok && !same(have, want) {
+			t.Errorf("match at %d: DFA found %v, NFA found %v", pos, have, want)
+		}
+		if have := re.FindStringIndex(s[pos:]); have == nil || have[1] != len(s)-pos {
+			t.Errorf("FindStringIndex at %d = %v", pos, have)
+		}
+	}
+}
+
+func TestReverseProg(t *testing.T) {
+	for _, test := range findTests {
+		re := MustCompile(test.pat)
+		for _, m := range test.matches {
+			fwd := newRuneClasses(re.prog)
+			d := newDFA(reverseProg(re.prog), fwd, true, true, true)
+			start, ok := d.backward(nil, test.text, 0, m[1])
+			if !ok {
+				t.Errorf("%#q in %#q: reverse DFA gave up", test.pat, test.text)
+				continue
+			}
+			// The match must start at the leftmost possible position,
+			// which is never after the one the NFA found.
+			if start < 0 || start > m[0] {
+				t.Errorf("%#q in %#q ending at %d: reverse DFA found start %d, want at most %d", test.pat, test.text, m[1], start, m[0])
+			}
+		}
+	}
+}
+
+// attCorpus returns the regexps and texts of the AT&T tests in testdata
+// that compile as Perl regexps.
+func attCorpus(b testing.TB) (res []*Regexp, texts []string) {
+	files, err := filepath.Glob("testdata/*.dat")
+	if err != nil {
+		b.Fatal(err)
+	}
+	for _, file := range files {
+		f, err := os.Open(file)
+		if err != nil {
+			b.Fatal(err)
+		}
+		r := bufio.NewReader(f)
+		for {
+			line, err := r.ReadString('\n')
+			if err != nil {
+				if err != io.EOF {
+					b.Fatal(err)
+				}
+				break
+			}
+			if line[0] == '#' || line[0] == '\n' {
+				continue
+			}
+			field := notab.FindAllString(strings.TrimSuffix(line, "\n"), -1)
+			if len(field) < 4 || field[1] == "NIL" || field[2] == "NIL" {
+				continue
+			}
+			if field[2] == "NULL" {
+				field[2] = ""
+			}
+			re, err := Compile(field[1])
+			if err != nil {
+				continue
+			}
+			res = append(res, re)
+			texts = append(texts, field[2])
+		}
+		f.Close()
+	}
+	return res, texts
+}
+
+func BenchmarkMatchATT(b *testing.B) {
+	res, texts := attCorpus(b)
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		for j, re := range res {
+			re.MatchString(texts[j])
+		}
+	}
+}
+
+func BenchmarkFindIndexATT(b *testing.B) {
+	res, texts := attCorpus(b)
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		for j, re := range res {
+			re.FindStringIndex(texts[j])
+		}
+	}
+}
+
+func BenchmarkFindAllIndexLong(b *testing.B) {
+	re := MustCompile(`[A-Z][a-z]+ [0-9]+`)
+	t := makeText(1 << 20)
+	b.SetBytes(int64(len(t)))
+	for i := 0; i < b.N; i++ {
+		re.FindAllIndex(t, -1)
+	}
+}
@@ -40,6 +40,7 @@ type machine struct {
 	op             *onePassProg // compiled onepass program, or notOnePass
 	maxBitStateLen int          // max length of string to search with bitstate
 	b              *bitState    // state for backtracker, allocated lazily
+	dfa            dfaSet       // lazy DFAs for byte slice and string inputs
 	q0, q1         queue        // two queues for runq, nextq
 	pool           []*thread    // pool of available threads
 	matched        bool         // whether a match was found
@@ -416,6 +417,11 @@ func (re *Regexp) doMatch(r io.RuneReader, b []byte, s string) bool {
 //
 // nil is returned if no matches are found and non-nil if matches are found.
 func (re *Regexp) doExecute(r io.RuneReader, b []byte, s string, pos int, ncap int, dstCap []int) []int {
+	// Searches that continue from an earlier match (pos > 0) have
+	// already been through the prefilter.
+	if r == nil && pos == 0 && !re.prefilter.mayMatch(b, s, pos) {
+		return nil
+	}
 	m := re.get()
 	var i input
 	var size int
@@ -433,19 +439,31 @@ func (re *Regexp) doExecute(r io.RuneReader, b []byte, s string, pos int, ncap i
 			re.put(m)
 			return nil
 		}
-	} else if size < m.maxBitStateLen && r == nil {
-		if m.b == nil {
-			m.b = newBitState(m.p)
-		}
-		if !m.backtrack(i, pos, size, ncap) {
+	} else if matched, ok := m.dfaExecute(r, b, s, pos, ncap); ok && (!matched || ncap <= 2) {
+		if !matched {
 			re.put(m)
 			return nil
 		}
 	} else {
-		m.init(ncap)
-		if !m.match(i, pos) {
-			re.put(m)
-			return nil
+		if ok {
+			// The DFA found where the match starts;
+			// find its submatches from there.
+			pos = m.matchcap[0]
+		}
+		if size < m.maxBitStateLen && r == nil {
+			if m.b == nil {
+				m.b = newBitState(m.p)
+			}
+			if !m.backtrack(i, pos, size, ncap) {
+				re.put(m)
+				return nil
+			}
+		} else {
+			m.init(ncap)
+			if !m.match(i, pos) {
+				re.put(m)
+				return nil
+			}
 		}
 	}
 	dstCap = append(dstCap, m.matchcap...)
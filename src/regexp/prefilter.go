@@ -0,0 +1,339 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+package regexp
+
+import (
+	"bytes"
+	"regexp/syntax"
+	"sort"
+	"strings"
+	"unicode/utf8"
+)
+
+// A prefilter holds literal strings extracted from a regexp that let a
+// search rule out text without running a matching engine. The searches
+// for them use bytes.Index and strings.Index, which are implemented in
+// assembly with vector instructions on most architectures.
+type prefilter struct {
+	// Every match contains each of required.
+	required      []string
+	requiredBytes [][]byte
+
+	// Every match begins with one of starts, or starts is nil.
+	starts      []string
+	startsBytes [][]byte
+}
+
+const (
+	maxLitExact    = 16 // most strings tracked for a set of exact matches
+	maxLitStarts   = 16 // most literals a prefilter searches for match starts
+	maxLitRequired = 4  // most literals a prefilter requires
+)
+
+// newPrefilter returns the prefilter for the simplified regexp re, or
+// nil if no literal would help. Required literals that begin every
+// match are dropped: the search for match starts already finds them.
+func newPrefilter(re *syntax.Regexp, prefix string) *prefilter {
+	info := literals(re)
+	f := new(prefilter)
+	lead := prefix
+	if prefix == "" {
+		if starts := info.firstSet(); len(starts) == 1 || len(starts) <= maxLitStarts && minLen(starts) > 1 {
+			// Searching for several single bytes would stop
+			// too often to pay off.
+			f.starts = starts
+			if len(starts) == 1 {
+				lead = starts[0]
+			}
+		}
+	}
+	var req []string
+	for _, lit := range info.requiredSet() {
+		if !strings.HasPrefix(lead, lit) {
+			req = append(req, lit)
+		}
+	}
+	// Longer literals are rarer; prefer them.
+	sort.SliceStable(req, func(i, j int) bool { return len(req[i]) > len(req[j]) })
+	for _, lit := range req {
+		if len(f.required) == maxLitRequired {
+			break
+		}
+		if !containsString(f.required, lit) {
+			f.required = append(f.required, lit)
+		}
+	}
+	if f.starts == nil && f.required == nil {
+		return nil
+	}
+	for _, lit := range f.required {
+		f.requiredBytes = append(f.requiredBytes, []byte(lit))
+	}
+	for _, lit := range f.starts {
+		f.startsBytes = append(f.startsBytes, []byte(lit))
+	}
+	return f
+}
+
+// mayMatch reports whether the input from pos on contains every
+// required literal. If it does not, there is no match.
+func (f *prefilter) mayMatch(b []byte, s string, pos int) bool {
+	if f == nil {
+		return true
+	}
+	for i, lit := range f.required {
+		if b != nil {
+			if bytes.Index(b[pos:], f.requiredBytes[i]) < 0 {
+				return false
+			}
+		} else if !strings.Contains(s[pos:], lit) {
+			return false
+		}
+	}
+	return true
+}
+
+// indexStart returns the smallest position at or after pos where one
+// of f.starts occurs in the input, or -1 if there is none. next[i]
+// caches the position of the next occurrence of f.starts[i] (-1 if
+// there is none, -2 if unknown) between calls with increasing pos on
+// the same input.
+func (f *prefilter) indexStart(b []byte, s string, pos int, next []int) int {
+	q := -1
+	for i, lit := range f.starts {
+		j := next[i]
+		if j == -1 {
+			continue
+		}
+		if j < pos {
+			if b != nil {
+				j = bytes.Index(b[pos:], f.startsBytes[i])
+			} else {
+				j = strings.Index(s[pos:], lit)
+			}
+			if j >= 0 {
+				j += pos
+			}
+			next[i] = j
+			if j < 0 {
+				continue
+			}
+		}
+		if q < 0 || j < q {
+			q = j
+		}
+	}
+	return q
+}
+
+// litInfo describes the literal strings found in the matches of a
+// regexp.
+type litInfo struct {
+	exact    []string // if non-nil, the regexp matches exactly these strings
+	first    []string // if non-nil, every match begins with one of these non-empty strings
+	required []string // every match contains each of these non-empty strings
+}
+
+// firstSet returns a set of non-empty strings one of which begins every
+// match, or nil if there is no such set.
+func (x *litInfo) firstSet() []string {
+	if x.exact != nil {
+		if containsString(x.exact, "") {
+			return nil
+		}
+		return x.exact
+	}
+	return x.first
+}
+
+// requiredSet returns non-empty strings every match contains.
+func (x *litInfo) requiredSet() []string {
+	if x.exact != nil {
+		if len(x.exact) == 1 && x.exact[0] != "" {
+			return x.exact
+		}
+		return nil
+	}
+	return x.required
+}
+
+// literals computes the litInfo of re, which must be simplified.
+func literals(re *syntax.Regexp) litInfo {
+	switch re.Op {
+	case syntax.OpEmptyMatch, syntax.OpBeginLine, syntax.OpEndLine,
+		syntax.OpBeginText, syntax.OpEndText,
+		syntax.OpWordBoundary, syntax.OpNoWordBoundary:
+		return litInfo{exact: []string{""}}
+
+	case syntax.OpLiteral:
+		if re.Flags&syntax.FoldCase != 0 {
+			break
+		}
+		if lit := string(re.Rune); literalOK(lit) {
+			return litInfo{exact: []string{lit}}
+		}
+
+	case syntax.OpCharClass:
+		n := 0
+		for i := 0; i+1 < len(re.Rune); i += 2 {
+			n += int(re.Rune[i+1]-re.Rune[i]) + 1
+			if n > maxLitExact {
+				break
+			}
+		}
+		if n == 0 || n > maxLitExact {
+			break
+		}
+		var exact []string
+		for i := 0; i+1 < len(re.Rune); i += 2 {
+			for r := re.Rune[i]; r <= re.Rune[i+1]; r++ {
+				lit := string(r)
+				if !literalOK(lit) {
+					return litInfo{}
+				}
+				exact = append(exact, lit)
+			}
+		}
+		return litInfo{exact: exact}
+
+	case syntax.OpCapture:
+		return literals(re.Sub[0])
+
+	case syntax.OpQuest:
+		x := literals(re.Sub[0])
+		if x.exact != nil && len(x.exact) < maxLitExact {
+			return litInfo{exact: unionStrings(x.exact, []string{""})}
+		}
+
+	case syntax.OpPlus:
+		x := literals(re.Sub[0])
+		return litInfo{first: x.firstSet(), required: x.requiredSet()}
+
+	case syntax.OpConcat:
+		return concatLiterals(re.Sub)
+
+	case syntax.OpAlternate:
+		var exact, first []string
+		allExact, allFirst := true, true
+		for _, sub := range re.Sub {
+			x := literals(sub)
+			if allExact && x.exact != nil {
+				exact = unionStrings(exact, x.exact)
+			} else {
+				allExact = false
+			}
+			if f := x.firstSet(); allFirst && f != nil {
+				first = unionStrings(first, f)
+			} else {
+				allFirst = false
+			}
+		}
+		if allExact && len(exact) <= maxLitExact {
+			return litInfo{exact: exact}
+		}
+		if allFirst && len(first) <= maxLitStarts {
+			return litInfo{first: first}
+		}
+	}
+	return litInfo{}
+}
+
+// concatLiterals computes the litInfo of the concatenation of subs.
+// Runs of subexpressions with exact sets are combined into the set of
+// their concatenations for as long as that stays small.
+func concatLiterals(subs []*syntax.Regexp) litInfo {
+	var info litInfo
+	run := []string{""} // concatenations of the current run of exact sets
+	firstDone := false  // info.first has been decided
+	split := false      // run does not cover all of subs
+	flush := func() {
+		if !firstDone && (len(run) != 1 || run[0] != "") {
+			if !containsString(run, "") {
+				info.first = run
+			}
+			firstDone = true
+		}
+		if len(run) == 1 && run[0] != "" {
+			info.required = append(info.required, run[0])
+		}
+	}
+	for _, sub := range subs {
+		x := literals(sub)
+		if x.exact != nil {
+			if len(run)*len(x.exact) <= maxLitExact {
+				run = crossStrings(run, x.exact)
+				continue
+			}
+			flush()
+			split = true
+			run = x.exact
+			continue
+		}
+		flush()
+		split = true
+		run = []string{""}
+		if !firstDone {
+			info.first = x.firstSet()
+			firstDone = true
+		}
+		info.required = append(info.required, x.requiredSet()...)
+	}
+	if !split {
+		return litInfo{exact: run}
+	}
+	flush()
+	return info
+}
+
+// literalOK reports whether a search for lit as bytes finds every place
+// a regexp matching lit as runes could match. That fails for
+// utf8.RuneError, which also matches invalid UTF-8.
+func literalOK(lit string) bool {
+	return !strings.ContainsRune(lit, utf8.RuneError)
+}
+
+// minLen returns the length of the shortest string in list.
+func minLen(list []string) int {
+	n := -1
+	for _, s := range list {
+		if n < 0 || len(s) < n {
+			n = len(s)
+		}
+	}
+	return n
+}
+
+func containsString(list []string, s string) bool {
+	for _, t := range list {
+		if t == s {
+			return true
+		}
+	}
+	return false
+}
+
+// unionStrings returns the strings in either x or y.
+func unionStrings(x, y []string) []string {
+	z := append([]string(nil), x...)
+	for _, s := range y {
+		if !containsString(z, s) {
+			z = append(z, s)
+		}
+	}
+	return z
+}
+
+// crossStrings returns each string in x followed by each string in y.
+func crossStrings(x, y []string) []string {
+	var z []string
+	for _, s := range x {
+		for _, t := range y {
+			if st := s + t; !containsString(z, st) {
+				z = append(z, st)
+			}
+		}
+	}
+	return z
+}
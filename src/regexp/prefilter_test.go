@@ -0,0 +1,137 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+package regexp
+
+import (
+	"fmt"
+	"reflect"
+	"strings"
+	"testing"
+)
+
+var prefilterTests = []struct {
+	re       string
+	required []string
+	starts   []string
+}{
+	{`abc`, nil, nil}, // all prefix
+	{`error.*timeout`, []string{"timeout"}, nil},
+	{`(foo|bar|baz)\d+`, nil, []string{"foo", "bar", "baz"}},
+	{`[XYZ]ABC`, nil, []string{"XABC", "YABC", "ZABC"}},
+	{`\bGET /api/v\d+/users`, []string{"/users"}, []string{"GET /api/v"}},
+	{`(GET|POST) /api`, nil, []string{"GET /api", "POST /api"}},
+	{`x+y+`, []string{"y"}, nil}, // x is the prefix
+	{`\d+\.\d+\.\d+\.\d+`, []string{"."}, nil},
+	{`a?b`, nil, nil},
+	{`a?bc`, nil, []string{"abc", "bc"}},
+	{`a*b`, []string{"b"}, nil},
+	{`.*`, nil, nil},
+	{`(?i)abc`, nil, nil},
+	{`^abc.*def`, nil, nil}, // anchored: no prefilter
+	{`\x{FFFD}abc`, nil, nil},
+}
+
+func TestPrefilter(t *testing.T) {
+	for _, tt := range prefilterTests {
+		re := MustCompile(tt.re)
+		f := re.prefilter
+		var required, starts []string
+		if f != nil {
+			required, starts = f.required, f.starts
+		}
+		if !reflect.DeepEqual(required, tt.required) || !reflect.DeepEqual(starts, tt.starts) {
+			t.Errorf("%#q: prefilter required %q, starts %q; want %q, %q", tt.re, required, starts, tt.required, tt.starts)
+		}
+	}
+}
+
+func TestPrefilterIndexStart(t *testing.T) {
+	f := &prefilter{starts: []string{"foo", "bar"}}
+	f.startsBytes = [][]byte{[]byte("foo"), []byte("bar")}
+	s := "xxbarxfooxbar"
+	next := []int{-2, -2}
+	var have []int
+	for pos := 0; ; pos++ {
+		q := f.indexStart(nil, s, pos, next)
+		if q < 0 {
+			break
+		}
+		have = append(have, q)
+		pos = q
+	}
+	if want := []int{2, 6, 10}; !reflect.DeepEqual(have, want) {
+		t.Errorf("indexStart positions = %v, want %v", have, want)
+	}
+}
+
+// makeLog returns n bytes of synthetic log lines. About one line in
+// 1000 mentions a timeout.
+func makeLog(n int) []byte {
+	levels := []string{"INFO", "INFO", "INFO", "DEBUG", "WARN", "error"}
+	paths := []string{"/api/v1/users", "/api/v2/orders", "/static/app.js", "/healthz"}
+	var b strings.Builder
+	x := uint32(12345)
+	for i := 0; b.Len() < n; i++ {
+		x = x*1664525 + 1013904223
+		fmt.Fprintf(&b, "2018-06-%02d 12:%02d:%02d.%03d %s [worker-%d] 10.0.%d.%d %s %s",
+			1+x%28, x>>8%60, x>>14%60, x>>20%1000, levels[x>>4%uint32(len(levels))],
+			x>>10%16, x>>12%256, x>>16%256,
+			[]string{"GET", "POST", "PUT"}[x>>6%3], paths[x>>9%uint32(len(paths))])
+		if i%1000 == 999 {
+			b.WriteString(" upstream timeout after 30s")
+		} else {
+			fmt.Fprintf(&b, " status=%d bytes=%d", 200+x>>3%4, x>>5%100000)
+		}
+		b.WriteByte('\n')
+	}
+	return []byte(b.String()[:n])
+}
+
+var logBenchmarks = []struct{ name, re string }{
+	{"ErrorTimeout", `error.*timeout`},
+	{"Alternation", `(PATCH|DELETE|HEAD) /api`},
+	{"AlternationDigits", `(foo|bar|baz)\d+`},
+	{"RequiredLiteral", `\[worker-\d+\] .*timeout`},
+	{"IPAddress", `\b10\.0\.1\.\d+\b`},
+}
+
+func BenchmarkLogLines(b *testing.B) {
+	lines := strings.Split(string(makeLog(1<<20)), "\n")
+	for _, bm := range logBenchmarks {
+		re := MustCompile(bm.re)
+		b.Run(bm.name, func(b *testing.B) {
+			b.SetBytes(1 << 20)
+			for i := 0; i < b.N; i++ {
+				for _, line := range lines {
+					re.MatchString(line)
+				}
+			}
+		})
+	}
+}
+
+func BenchmarkLogFindAll(b *testing.B) {
+	text := makeLog(1 << 20)
+	for _, bm := range logBenchmarks {
+		re := MustCompile(bm.re)
+		b.Run(bm.name, func(b *testing.B) {
+			b.SetBytes(int64(len(text)))
+			for i := 0; i < b.N; i++ {
+				re.FindAllIndex(text, -1)
+			}
+		})
+	}
+}
+
+func BenchmarkLogSubmatch(b *testing.B) {
+	lines := strings.Split(string(makeLog(1<<20)), "\n")
+	re := MustCompile(`(error|WARN) .* (\S+) upstream (timeout)`)
+	b.SetBytes(1 << 20)
+	for i := 0; i < b.N; i++ {
+		for _, line := range lines {
+			re.FindStringSubmatchIndex(line)
+		}
+	}
+}
@@ -96,6 +96,7 @@ type regexpRO struct {
 	prefixComplete bool           // prefix is the entire regexp
 	prefixRune     rune           // first rune in prefix
 	prefixEnd      uint32         // pc for last rune in prefix
+	prefilter      *prefilter     // literals to search for, or nil
 	cond           syntax.EmptyOp // empty-width conditions required at start of match
 	numSubexp      int
 	subexpNames    []string
@@ -201,6 +202,9 @@ func compile(expr string, mode syntax.Flags, longest bool) (*Regexp, error) {
 		regexp.prefixBytes = []byte(regexp.prefix)
 		regexp.prefixRune, _ = utf8.DecodeRuneInString(regexp.prefix)
 	}
+	if regexp.cond&syntax.EmptyBeginText == 0 {
+		regexp.prefilter = newPrefilter(re, regexp.prefix)
+	}
 	return regexp, nil
 }
 
@@ -0,0 +1,248 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+package regexp
+
+import (
+	"regexp/syntax"
+	"sort"
+	"sync"
+	"unicode/utf8"
+)
+
+// setMaxMem is the state cache budget of a Set's dfa. Set states hold
+// threads for many patterns at once, so they are larger than those of
+// a single regexp.
+const setMaxMem = 8 * dfaMaxMem
+
+// A Set is a list of regular expressions that are matched against
+// text together, in a single pass over the input, reporting which of
+// them match. It is much faster than matching each Regexp in turn when
+// there are many patterns.
+//
+// A Set reports only whether each pattern matches, not where.
+// A Set is safe for concurrent use by multiple goroutines.
+type Set struct {
+	exprs   []string
+	prog    *syntax.Prog // the programs of all patterns
+	pattern []int32      // the pattern each instruction of prog belongs to
+	classes *runeClasses // nil if a dfa would not pay off
+
+	// cache of dfas for running the set
+	mu  sync.Mutex
+	dfa []*dfa
+}
+
+// CompileSet parses the regular expressions in exprs, using the syntax
+// accepted by Compile, and returns a Set matching them. Pattern i of
+// the Set is exprs[i].
+func CompileSet(exprs []string) (*Set, error) {
+	// Each pattern is compiled on its own and its instructions are
+	// appended to a single program, renumbered. The program starts
+	// with a chain of Alt instructions leading to all patterns.
+	prog := &syntax.Prog{
+		Inst:   []syntax.Inst{{Op: syntax.InstFail}},
+		NumCap: 2,
+	}
+	pattern := []int32{0}
+	starts := make([]uint32, len(exprs))
+	for i, expr := range exprs {
+		re, err := syntax.Parse(expr, syntax.Perl)
+		if err != nil {
+			return nil, err
+		}
+		p, err := syntax.Compile(re.Simplify())
+		if err != nil {
+			return nil, err
+		}
+		base := uint32(len(prog.Inst))
+		for _, inst := range p.Inst {
+			inst.Out += base
+			if inst.Op == syntax.InstAlt || inst.Op == syntax.InstAltMatch {
+				inst.Arg += base
+			}
+			prog.Inst = append(prog.Inst, inst)
+			pattern = append(pattern, int32(i))
+		}
+		starts[i] = base + uint32(p.Start)
+	}
+	prog.Start = 0 // no patterns: fail
+	if n := len(starts); n > 0 {
+		next := starts[n-1]
+		for i := n - 2; i >= 0; i-- {
+			prog.Inst = append(prog.Inst, syntax.Inst{Op: syntax.InstAlt, Out: starts[i], Arg: next})
+			pattern = append(pattern, 0)
+			next = uint32(len(prog.Inst) - 1)
+		}
+		prog.Start = int(next)
+	}
+	return &Set{
+		exprs:   append([]string(nil), exprs...),
+		prog:    prog,
+		pattern: pattern,
+		classes: newRuneClasses(prog),
+	}, nil
+}
+
+// MustCompileSet is like CompileSet but panics if an expression cannot
+// be parsed.
+func MustCompileSet(exprs []string) *Set {
+	s, err := CompileSet(exprs)
+	if err != nil {
+		panic(`regexp: CompileSet: ` + err.Error())
+	}
+	return s
+}
+
+// Len returns the number of patterns in the set.
+func (s *Set) Len() int {
+	return len(s.exprs)
+}
+
+// Match returns the indexes of the patterns that match somewhere in b,
+// in increasing order, or nil if none of them do.
+func (s *Set) Match(b []byte) []int {
+	if b == nil {
+		b = []byte{}
+	}
+	return s.match(b, "")
+}
+
+// MatchString returns the indexes of the patterns that match somewhere
+// in str, in increasing order, or nil if none of them do.
+func (s *Set) MatchString(str string) []int {
+	return s.match(nil, str)
+}
+
+func (s *Set) match(b []byte, str string) []int {
+	d := s.get()
+	var m []int
+	for _, pc := range d.scanSet(b, str) {
+		if s.prog.Inst[pc].Op == syntax.InstMatch {
+			m = append(m, int(s.pattern[pc]))
+		}
+	}
+	s.put(d)
+	sort.Ints(m)
+	return m
+}
+
+// get returns a dfa to use for matching s, from the cache if possible.
+func (s *Set) get() *dfa {
+	s.mu.Lock()
+	if n := len(s.dfa); n > 0 {
+		d := s.dfa[n-1]
+		s.dfa = s.dfa[:n-1]
+		s.mu.Unlock()
+		return d
+	}
+	s.mu.Unlock()
+	d := newDFA(s.prog, s.classes, true, false, false)
+	d.pattern = s.pattern
+	d.npattern = len(s.exprs)
+	d.done = make([]bool, len(s.exprs))
+	d.maxMem = setMaxMem
+	return d
+}
+
+// put returns d to the cache of s.
+func (s *Set) put(d *dfa) {
+	s.mu.Lock()
+	s.dfa = append(s.dfa, d)
+	s.mu.Unlock()
+}
+
+// scanSet runs the dfa of a Set over the whole input, or until every
+// pattern has matched, and returns the instructions of the last state.
+// If the states do not fit in the cache, it continues without caching
+// them.
+func (d *dfa) scanSet(b []byte, s string) []uint32 {
+	if d.classes == nil {
+		return d.scanSetSlow(b, s, 0, nil, dfaKindText|dfaStart)
+	}
+	n := len(s)
+	if b != nil {
+		n = len(b)
+	}
+	d.resetAt = -1
+	st := d.start(dfaKindText)
+	for p := 0; ; {
+		// Fast path: run over ASCII text while no state needs attention.
+		if b != nil {
+			for p < n && b[p] < utf8.RuneSelf {
+				ns := st.next[d.classes.ascii[b[p]]]
+				if ns == nil || ns.stop {
+					break
+				}
+				st = ns
+				p++
+			}
+		} else {
+			for p < n && s[p] < utf8.RuneSelf {
+				ns := st.next[d.classes.ascii[s[p]]]
+				if ns == nil || ns.stop {
+					break
+				}
+				st = ns
+				p++
+			}
+		}
+		r, w := decodeRuneAt(b, s, p)
+		c := d.classes.n
+		if w > 0 {
+			if r < utf8.RuneSelf {
+				c = int(d.classes.ascii[r])
+			} else {
+				c = d.classes.search(r)
+			}
+		}
+		ns := st.next[c]
+		if ns == nil {
+			if ns = d.transition(st, r, c, p); ns == nil {
+				return d.scanSetSlow(b, s, p, st.insts, st.flag)
+			}
+		}
+		if w == 0 || ns.stop {
+			return ns.insts
+		}
+		st = ns
+		p += w
+	}
+}
+
+// scanSetSlow is like scanSet but computes each state afresh, starting
+// from the state with the given instructions and flag at position p.
+func (d *dfa) scanSetSlow(b []byte, s string, p int, insts []uint32, flag uint8) []uint32 {
+	cur := append([]uint32(nil), insts...)
+	for {
+		r, w := decodeRuneAt(b, s, p)
+		next, nflag := d.follow(cur, flag, r)
+		cur, flag = append(cur[:0], next...), nflag
+		if w == 0 || d.matches(cur) == d.npattern {
+			return cur
+		}
+		p += w
+	}
+}
+
+// decodeRuneAt returns the rune at position p of the input and its
+// width, or endOfText and 0 at the end of the input.
+func decodeRuneAt(b []byte, s string, p int) (rune, int) {
+	if b != nil {
+		if p >= len(b) {
+			return endOfText, 0
+		}
+		if c := b[p]; c < utf8.RuneSelf {
+			return rune(c), 1
+		}
+		return utf8.DecodeRune(b[p:])
+	}
+	if p >= len(s) {
+		return endOfText, 0
+	}
+	if c := s[p]; c < utf8.RuneSelf {
+		return rune(c), 1
+	}
+	return utf8.DecodeRuneInString(s[p:])
+}
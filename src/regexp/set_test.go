@@ -0,0 +1,179 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+package regexp
+
+import (
+	"fmt"
+	"reflect"
+	"strings"
+	"testing"
+)
+
+var setTests = []struct {
+	exprs []string
+	text  string
+	want  []int
+}{
+	{nil, "abc", nil},
+	{[]string{"a", "b", "c"}, "", nil},
+	{[]string{"a", "b", "c"}, "cab", []int{0, 1, 2}},
+	{[]string{"a", "b", "c"}, "xbx", []int{1}},
+	{[]string{"", "x"}, "", []int{0}},
+	{[]string{`^abc`, `abc$`, `^abc$`}, "abc", []int{0, 1, 2}},
+	{[]string{`^abc`, `abc$`, `^abc$`}, "abcabc", []int{0, 1}},
+	{[]string{`\bfoo\b`, `foo\B`, `(?m)^bar$`}, "x foobar\nbar", []int{1, 2}},
+	{[]string{`a+b`, `a*b`, `ab{2}`}, "aab", []int{0, 1}},
+	{[]string{`[α-ω]+`, `\p{Greek}\d`, `☺`}, "δ1 x", []int{0, 1}},
+	{[]string{`error.*timeout`, `timeout`, `error`}, "error: upstream timeout", []int{0, 1, 2}},
+	{[]string{`(?i)HELLO`, `hello`, `Hello`}, "hello", []int{0, 1}},
+}
+
+func TestSet(t *testing.T) {
+	for _, tt := range setTests {
+		s := MustCompileSet(tt.exprs)
+		if s.Len() != len(tt.exprs) {
+			t.Errorf("%q: Len() = %d", tt.exprs, s.Len())
+		}
+		if have := s.MatchString(tt.text); !reflect.DeepEqual(have, tt.want) {
+			t.Errorf("%q: MatchString(%q) = %v, want %v", tt.exprs, tt.text, have, tt.want)
+		}
+		if have := s.Match([]byte(tt.text)); !reflect.DeepEqual(have, tt.want) {
+			t.Errorf("%q: Match(%q) = %v, want %v", tt.exprs, tt.text, have, tt.want)
+		}
+	}
+}
+
+func TestCompileSetError(t *testing.T) {
+	if _, err := CompileSet([]string{"a", "b(", "c"}); err == nil {
+		t.Error("CompileSet accepted invalid regexp")
+	}
+}
+
+// setMatchEach returns the indexes of the regexps that match text.
+func setMatchEach(res []*Regexp, text string) []int {
+	var m []int
+	for i, re := range res {
+		if re.MatchString(text) {
+			m = append(m, i)
+		}
+	}
+	return m
+}
+
+// TestSetATT checks a Set holding all the regexps of the AT&T tests in
+// testdata against matching each regexp on its own, both with the dfa
+// and with the state cache disabled.
+func TestSetATT(t *testing.T) {
+	res, texts := attCorpus(t)
+	exprs := make([]string, len(res))
+	for i, re := range res {
+		exprs[i] = re.String()
+	}
+	s := MustCompileSet(exprs)
+	slow := MustCompileSet(exprs)
+	slow.classes = nil
+	seen := make(map[string]bool)
+	for _, text := range texts {
+		if seen[text] {
+			continue
+		}
+		seen[text] = true
+		want := setMatchEach(res, text)
+		if have := s.MatchString(text); !reflect.DeepEqual(have, want) {
+			t.Errorf("MatchString(%q) = %v, want %v", text, have, want)
+		}
+		if have := slow.MatchString(text); !reflect.DeepEqual(have, want) {
+			t.Errorf("without dfa: MatchString(%q) = %v, want %v", text, have, want)
+		}
+	}
+}
+
+func TestSetCacheFlush(t *testing.T) {
+	// As in TestDFACacheFlush, the text visits more states than fit
+	// in the cache.
+	exprs := []string{`(a|b)*a(a|b){15}c`, `(a|b)*b(a|b){15}c`, `ac`, `d`}
+	text := make([]byte, 1<<16)
+	x := uint32(1)
+	for i := range text {
+		x = x*1664525 + 1013904223
+		text[i] = 'a' + byte(x>>31)
+	}
+	s := MustCompileSet(exprs)
+	d := s.get()
+	d.maxMem = dfaMaxMem / 16
+	s.put(d)
+	for _, tail := range []string{"", "c"} {
+		str := string(text) + tail
+		res := make([]*Regexp, len(exprs))
+		for i, expr := range exprs {
+			res[i] = MustCompile(expr)
+		}
+		want := setMatchEach(res, str)
+		if have := s.MatchString(str); !reflect.DeepEqual(have, want) {
+			t.Errorf("MatchString(text+%q) = %v, want %v", tail, have, want)
+		}
+	}
+}
+
+// setPatterns returns n patterns in the style of log classification
+// rules: mostly literal words with some classes and repetitions.
+func setPatterns(n int) []string {
+	words := []string{"error", "warn", "timeout", "refused", "upstream", "worker", "disk", "cache", "login", "token"}
+	exprs := make([]string, n)
+	for i := range exprs {
+		w1, w2 := words[i%len(words)], words[i/len(words)%len(words)]
+		switch i % 4 {
+		case 0:
+			exprs[i] = fmt.Sprintf(`%s.*%s%d`, w1, w2, i)
+		case 1:
+			exprs[i] = fmt.Sprintf(`\b%s%d\b`, w1, i)
+		case 2:
+			exprs[i] = fmt.Sprintf(`%s=\d+ %s%d`, w1, w2, i)
+		case 3:
+			exprs[i] = fmt.Sprintf(`\[%s-%d\]`, w1, i)
+		}
+	}
+	return exprs
+}
+
+func benchmarkSet(b *testing.B, n int, each bool) {
+	lines := strings.Split(string(makeLog(1<<16)), "\n")
+	exprs := setPatterns(n)
+	b.SetBytes(1 << 16)
+	if each {
+		res := make([]*Regexp, n)
+		for i, expr := range exprs {
+			res[i] = MustCompile(expr)
+		}
+		b.ResetTimer()
+		for i := 0; i < b.N; i++ {
+			for _, line := range lines {
+				for _, re := range res {
+					re.MatchString(line)
+				}
+			}
+		}
+		return
+	}
+	s := MustCompileSet(exprs)
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		for _, line := range lines {
+			s.MatchString(line)
+		}
+	}
+}
+
+func BenchmarkSet(b *testing.B) {
+	for _, n := range []int{10, 100, 1000} {
+		b.Run(fmt.Sprint(n), func(b *testing.B) { benchmarkSet(b, n, false) })
+	}
+}
+
+func BenchmarkSetEach(b *testing.B) {
+	for _, n := range []int{10, 100, 1000} {
+		b.Run(fmt.Sprint(n), func(b *testing.B) { benchmarkSet(b, n, true) })
+	}
+}
@@ -0,0 +1,357 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+package regexp
+
+import (
+	"bytes"
+	"regexp/syntax"
+	"unicode/utf8"
+)
+
+// A Stream finds the matches of a Regexp in text that arrives in
+// chunks, such as a large file or a network connection, without
+// buffering all of it and without the cost of matching through an
+// io.RuneReader. It reports the same matches as FindAllIndex would for
+// the concatenation of the chunks, as offsets from the beginning of the
+// stream.
+//
+// A Stream runs the lazy DFA over each chunk as it arrives, carrying
+// the DFA state from one chunk to the next. It retains only the text
+// from the earliest point at which a match may be in progress, which
+// for most regexps and inputs is a short tail of the last chunk; a
+// regexp like (?s)a.*b may need to retain everything after an a.
+//
+// A Stream is not safe for concurrent use. Any number of Streams may
+// use the same Regexp.
+type Stream struct {
+	re      *Regexp
+	fwd     *dfa // leftmost-first, to find where a match ends
+	rev     *dfa // reversed program, to find where it begins
+	longest *dfa // anchored leftmost-longest, to extend a match
+	slow    bool // no usable dfa: collect the text and match it at End
+
+	buf  []byte // retained text
+	base int64  // stream offset of buf[0]
+	done bool   // no more matches
+
+	// The search in progress. Positions are indexes into buf.
+	from    int       // where the search started
+	lo      int       // no match in progress starts before lo
+	skip    bool      // the search starts one rune after from
+	d       *dfa      // the dfa being run: fwd, or longest from start
+	st      *dfaState // state of d after buf[:scan]
+	scan    int
+	start   int   // start of the match being extended by longest
+	end     int   // end of the last match d found, or -1
+	limit   int   // d has stopped after buf[:limit]
+	prevEnd int64 // stream offset of the end of the previous match, or -1
+}
+
+// NewStream returns a Stream that reports the matches of re.
+func (re *Regexp) NewStream() *Stream {
+	s := &Stream{re: re}
+	if classes := newRuneClasses(re.prog); classes != nil {
+		anchored := re.cond&syntax.EmptyBeginText != 0
+		s.fwd = newDFA(re.prog, classes, false, anchored, false)
+		s.fwd.skip = !anchored && re.prefix != ""
+		s.rev = newDFA(reverseProg(re.prog), classes, true, true, true)
+		if re.longest {
+			s.longest = newDFA(re.prog, classes, true, true, false)
+		}
+	} else {
+		s.slow = true
+	}
+	s.Reset()
+	return s
+}
+
+// Reset discards the state of s, so that it can be used for a new
+// stream.
+func (s *Stream) Reset() {
+	s.buf = s.buf[:0]
+	s.base = 0
+	s.done = s.re.cond == ^syntax.EmptyOp(0) // impossible
+	s.prevEnd = -1
+	s.skip = false
+	s.search(0)
+}
+
+// Feed adds chunk to the stream and returns dst with the start and end
+// offsets of each match that chunk completes appended, as for
+// FindAllIndex but flattened. A match is completed once no later text
+// can change it, which may be several chunks after it ends.
+// Feed does not retain chunk.
+func (s *Stream) Feed(dst []int64, chunk []byte) []int64 {
+	if s.done {
+		return dst
+	}
+	s.buf = append(s.buf, chunk...)
+	if s.slow {
+		return dst
+	}
+	return s.run(dst, false)
+}
+
+// End marks the end of the stream and returns dst with the remaining
+// matches appended. After End, s reports no further matches until it
+// is Reset.
+func (s *Stream) End(dst []int64) []int64 {
+	if s.slow {
+		dst = s.runSlow(dst)
+	} else if !s.done {
+		dst = s.run(dst, true)
+	}
+	s.done = true
+	s.buf = s.buf[:0]
+	return dst
+}
+
+// search starts the search for the next match at pos.
+func (s *Stream) search(pos int) {
+	s.from, s.lo = pos, pos
+	s.d, s.scan, s.end = s.fwd, pos, -1
+	s.st = nil // set by run once the rune before pos is known
+}
+
+// run continues the search over the text in buf, reporting matches
+// in dst. If final is set, buf holds the rest of the stream.
+func (s *Stream) run(dst []int64, final bool) []int64 {
+	for !s.done {
+		if s.skip {
+			// After an empty match, search again from the next rune.
+			if s.from == len(s.buf) {
+				if final {
+					s.done = true
+				}
+				break
+			}
+			if !final && !utf8.FullRune(s.buf[s.from:]) {
+				break
+			}
+			_, w := utf8.DecodeRune(s.buf[s.from:])
+			s.skip = false
+			s.search(s.from + w)
+		}
+		if s.d == s.fwd && s.base+int64(s.from) > 0 && s.re.cond&syntax.EmptyBeginText != 0 {
+			// Anchored match, past beginning of text.
+			s.done = true
+			break
+		}
+		if s.st == nil {
+			s.st = s.d.start(s.d.kindBefore(s.buf, "", s.scan))
+		}
+		if !s.scanDFA(final) {
+			if s.slow && final {
+				return s.runSlow(dst)
+			}
+			break
+		}
+		if s.end < 0 {
+			// No match.
+			s.done = true
+			break
+		}
+		if s.d == s.fwd {
+			s.start = s.matchStart()
+			if s.longest != nil {
+				s.lo = s.start
+				s.d, s.scan, s.end, s.st = s.longest, s.start, -1, nil
+				continue
+			}
+		}
+		dst = s.found(dst, s.start, s.end)
+	}
+	s.trim()
+	return dst
+}
+
+// scanDFA runs s.d over buf from s.scan. It returns false if it needs
+// more text, or if the dfa gave up, in which case it sets s.slow.
+// Otherwise d's search is over: s.end is where the last match it found
+// ends, or -1, and s.limit is how far it read.
+func (s *Stream) scanDFA(final bool) bool {
+	d, st, p, b := s.d, s.st, s.scan, s.buf
+	n := len(b)
+	defer func() {
+		s.st, s.scan = st, p
+	}()
+	for {
+		if st.idle() {
+			s.lo = p
+			if d.skip {
+				// Match requires a literal prefix; fast search for it.
+				q := bytes.Index(b[p:], s.re.prefixBytes)
+				if q < 0 {
+					if final {
+						s.limit = n
+						return true
+					}
+					// Keep any partial prefix at the end.
+					q = n - len(s.re.prefixBytes) + 1
+					for q > p && q < n && !utf8.RuneStart(b[q]) {
+						q--
+					}
+					if q <= p {
+						return false
+					}
+					p, st = q, d.start(d.kindBefore(b, "", q))
+					s.lo = p
+					return false
+				}
+				if q > 0 {
+					p += q
+					st = d.start(d.kindBefore(b, "", p))
+					s.lo = p
+				}
+			}
+		}
+		// Fast path: run over ASCII text while no state needs attention.
+		for p < n && b[p] < utf8.RuneSelf {
+			ns := st.next[d.classes.ascii[b[p]]]
+			if ns == nil || ns.stop {
+				break
+			}
+			st = ns
+			p++
+		}
+		r, w, c := endOfText, 0, d.classes.n
+		if p < n {
+			if ch := b[p]; ch < utf8.RuneSelf {
+				r, w, c = rune(ch), 1, int(d.classes.ascii[ch])
+			} else {
+				if !final && !utf8.FullRune(b[p:]) {
+					return false
+				}
+				r, w = utf8.DecodeRune(b[p:])
+				c = d.classes.search(r)
+			}
+		} else if !final {
+			return false
+		}
+		ns := st.next[c]
+		if ns == nil {
+			if ns = d.transition(st, r, c, p); ns == nil {
+				// The cache filled too quickly. A stream has no
+				// other engine to hand the search to, so keep
+				// going with a fresh cache.
+				d.resetAt = -1
+				if ns = d.transition(st, r, c, p); ns == nil {
+					s.slow = true
+					return false
+				}
+			}
+		}
+		if ns.flag&dfaMatch != 0 {
+			s.end = p
+		}
+		if w == 0 || ns.dead() {
+			s.limit = p + w
+			return true
+		}
+		st = ns
+		p += w
+	}
+}
+
+// runSlow reports the matches in the rest of the stream, which buf
+// holds, without the dfas.
+func (s *Stream) runSlow(dst []int64) []int64 {
+	if s.from < s.lo {
+		// Searching from lo finds the same matches.
+		s.from = s.lo
+	}
+	for !s.done {
+		if s.skip {
+			if s.from == len(s.buf) {
+				break
+			}
+			_, w := utf8.DecodeRune(s.buf[s.from:])
+			s.skip = false
+			s.search(s.from + w)
+		}
+		if s.base+int64(s.from) > 0 && s.re.cond&syntax.EmptyBeginText != 0 {
+			break
+		}
+		loc := s.re.doExecute(nil, s.buf, "", s.from, 2, nil)
+		if loc == nil {
+			break
+		}
+		dst = s.found(dst, loc[0], loc[1])
+	}
+	s.done = true
+	return dst
+}
+
+// matchStart returns the start of the match ending at s.end that the
+// forward dfa found.
+func (s *Stream) matchStart() int {
+	if start, ok := s.rev.backward(s.buf, "", s.lo, s.end); ok && start >= 0 {
+		return start
+	}
+	// Invalid UTF-8: let the NFA find the start. The forward dfa
+	// stopped reading at s.limit because no match could be in
+	// progress there, so the rest of the stream cannot affect
+	// the result.
+	m := s.re.get()
+	m.init(2)
+	start := s.end
+	if m.match(m.newInputBytes(s.buf[:s.limit]), s.lo) {
+		start = m.matchcap[0]
+	}
+	s.re.put(m)
+	return start
+}
+
+// found reports the match buf[start:end] in dst, following the rules
+// of FindAllIndex for empty matches, and starts the next search.
+func (s *Stream) found(dst []int64, start, end int) []int64 {
+	accept := true
+	if end == s.from {
+		// An empty match right after a previous match is
+		// not allowed; the next search starts one rune on.
+		if s.base+int64(start) == s.prevEnd {
+			accept = false
+		}
+		s.skip = true
+		s.search(s.from)
+	} else {
+		s.search(end)
+	}
+	s.prevEnd = s.base + int64(end)
+	if accept {
+		dst = append(dst, s.base+int64(start), s.prevEnd)
+	}
+	return dst
+}
+
+// trim discards the text before s.lo, keeping the rune before it for
+// the empty-width operators.
+func (s *Stream) trim() {
+	if s.done {
+		s.buf = s.buf[:0]
+		return
+	}
+	keep := s.lo
+	if s.skip && s.from < keep {
+		keep = s.from
+	}
+	cut := keep - 1
+	for cut > 0 && keep-cut < utf8.UTFMax && !utf8.RuneStart(s.buf[cut]) {
+		cut--
+	}
+	if cut <= 0 || cut < len(s.buf)-cut {
+		// Wait until the copy would save more than it costs.
+		return
+	}
+	s.buf = s.buf[:copy(s.buf, s.buf[cut:])]
+	s.base += int64(cut)
+	s.from -= cut
+	s.lo -= cut
+	s.scan -= cut
+	s.start -= cut
+	if s.end >= 0 {
+		s.end -= cut
+	}
+}
@@ -0,0 +1,147 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+package regexp
+
+import (
+	"bytes"
+	"reflect"
+	"testing"
+)
+
+// streamFind feeds text to s in chunks of n bytes and returns the
+// matches it reports.
+func streamFind(s *Stream, text []byte, n int) []int64 {
+	s.Reset()
+	var locs []int64
+	for len(text) > n {
+		locs = s.Feed(locs, text[:n])
+		text = text[n:]
+	}
+	locs = s.Feed(locs, text)
+	return s.End(locs)
+}
+
+func findAllFlat(re *Regexp, text []byte) []int64 {
+	var locs []int64
+	for _, loc := range re.FindAllIndex(text, -1) {
+		locs = append(locs, int64(loc[0]), int64(loc[1]))
+	}
+	return locs
+}
+
+func testStream(t *testing.T, re *Regexp, text string) {
+	want := findAllFlat(re, []byte(text))
+	for _, slow := range []bool{false, true} {
+		s := re.NewStream()
+		if slow {
+			s.slow = true
+		}
+		for _, n := range []int{1, 2, 3, 5, len(text) + 1} {
+			if have := streamFind(s, []byte(text), n); !reflect.DeepEqual(have, want) {
+				t.Errorf("%#q in %#q, chunks of %d (slow=%v): stream found %v, want %v", re, text, n, slow, have, want)
+			}
+		}
+	}
+}
+
+func TestStream(t *testing.T) {
+	for _, test := range findTests {
+		re := MustCompile(test.pat)
+		testStream(t, re, test.text)
+		re.Longest()
+		testStream(t, re, test.text)
+	}
+}
+
+func TestStreamUTF8(t *testing.T) {
+	texts := []string{
+		"a☺b☺☺c",
+		"x\xffy\xe2\x98z☺",
+		"☺\n☺ word\xff☺",
+		"\xe2\x98\xba\xe2\x98",
+	}
+	pats := []string{``, `☺`, `☺+`, `\b`, `\B`, `\w+`, `[^a]`, `.`, `(?s).`, `\xff`, `y.z`, `(?m)^☺`, `☺$`, `x|☺\n☺`}
+	for _, pat := range pats {
+		re := MustCompile(pat)
+		for _, text := range texts {
+			testStream(t, re, text)
+		}
+	}
+}
+
+func TestStreamRetention(t *testing.T) {
+	// Matches are rare and short, so little text needs to be kept.
+	text := makeLog(1 << 20)
+	re := MustCompile(`upstream (timeout|reset)`)
+	s := re.NewStream()
+	const chunk = 4096
+	var locs []int64
+	max := 0
+	for p := 0; p < len(text); p += chunk {
+		locs = s.Feed(locs, text[p:p+chunk])
+		if len(s.buf) > max {
+			max = len(s.buf)
+		}
+	}
+	locs = s.End(locs)
+	if max > 2*chunk {
+		t.Errorf("stream retained %d bytes, want at most %d", max, 2*chunk)
+	}
+	if want := findAllFlat(re, text); !reflect.DeepEqual(locs, want) {
+		t.Errorf("stream found %d matches, want %d", len(locs)/2, len(want)/2)
+	}
+}
+
+func TestStreamCacheFlush(t *testing.T) {
+	// See TestDFACacheFlush. A Stream keeps going with a fresh cache.
+	re := MustCompile(`a(a|b){15}c`)
+	text := make([]byte, 1<<16)
+	x := uint32(1)
+	for i := range text {
+		x = x*1664525 + 1013904223
+		text[i] = "aabbc"[x>>29%5]
+	}
+	s := re.NewStream()
+	if have, want := streamFind(s, text, 4096), findAllFlat(re, text); !reflect.DeepEqual(have, want) {
+		t.Errorf("stream found %d matches, want %d", len(have)/2, len(want)/2)
+	}
+	if s.slow {
+		t.Errorf("stream gave up on the dfa")
+	}
+}
+
+func benchmarkStream(b *testing.B, pat string, text []byte) {
+	re := MustCompile(pat)
+	s := re.NewStream()
+	const chunk = 64 << 10
+	var locs []int64
+	b.SetBytes(int64(len(text)))
+	for i := 0; i < b.N; i++ {
+		s.Reset()
+		for p := 0; p < len(text); p += chunk {
+			locs = s.Feed(locs[:0], text[p:p+chunk])
+		}
+		locs = s.End(locs[:0])
+	}
+}
+
+func BenchmarkStream(b *testing.B) {
+	text := makeLog(16 << 20)
+	b.Run("NoMatch", func(b *testing.B) { benchmarkStream(b, `upstream timeout after 99s`, text) })
+	b.Run("Sparse", func(b *testing.B) { benchmarkStream(b, `upstream timeout`, text) })
+	b.Run("Alternation", func(b *testing.B) { benchmarkStream(b, `(PATCH|DELETE) /api`, text) })
+	b.Run("Dense", func(b *testing.B) { benchmarkStream(b, `\[worker-\d+\]`, text) })
+}
+
+// BenchmarkStreamReader is the io.RuneReader alternative to
+// BenchmarkStream/NoMatch.
+func BenchmarkStreamReader(b *testing.B) {
+	text := makeLog(16 << 20)
+	re := MustCompile(`upstream timeout after 99s`)
+	b.SetBytes(int64(len(text)))
+	for i := 0; i < b.N; i++ {
+		re.MatchReader(bytes.NewReader(text))
+	}
+}
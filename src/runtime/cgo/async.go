@@ -0,0 +1,21 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// +build darwin dragonfly freebsd linux netbsd openbsd solaris
+
+package cgo
+
+import _ "unsafe" // for go:linkname
+
+//go:cgo_import_static x_cgo_async_init
+//go:linkname x_cgo_async_init x_cgo_async_init
+//go:linkname _cgo_async_init runtime._cgo_async_init
+var x_cgo_async_init byte
+var _cgo_async_init = &x_cgo_async_init
+
+//go:cgo_import_static x_cgo_async_submit
+//go:linkname x_cgo_async_submit x_cgo_async_submit
+//go:linkname _cgo_async_submit runtime._cgo_async_submit
+var x_cgo_async_submit byte
+var _cgo_async_submit = &x_cgo_async_submit
@@ -0,0 +1,165 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// +build cgo
+// +build darwin dragonfly freebsd linux netbsd openbsd solaris
+
+// Worker threads for asynchronous cgo calls. See cgoasync.go in the
+// runtime.
+
+#include <pthread.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "libcgo.h"
+#include "libcgo_unix.h"
+
+// Keep in sync with cgoAsyncCall in cgoasync.go.
+struct cgo_async_call {
+	int32_t (*fn)(void*);
+	void *arg;
+	uintptr_t g;
+	struct cgo_async_call *next;
+	int32_t ret;
+};
+
+// Keep in sync with cgoAsyncInitArgs in cgoasync.go.
+struct cgo_async_init {
+	int32_t threads;
+	int32_t fd;
+	uintptr_t *done;
+};
+
+static pthread_mutex_t async_mu = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t async_cond = PTHREAD_COND_INITIALIZER;
+
+// Calls waiting for a worker, protected by async_mu.
+static struct cgo_async_call *async_head, *async_tail;
+static int async_queued;
+
+// Worker threads, protected by async_mu.
+static int async_threads, async_idle, async_max;
+
+static uintptr_t *async_done;
+static int async_wfd;
+
+static void*
+async_worker(void *unused) {
+	struct cgo_async_call *c;
+	uintptr_t old;
+	char b;
+
+	pthread_mutex_lock(&async_mu);
+	for (;;) {
+		while (async_head == nil) {
+			async_idle++;
+			pthread_cond_wait(&async_cond, &async_mu);
+			async_idle--;
+		}
+		c = async_head;
+		async_head = c->next;
+		if (async_head == nil) {
+			async_tail = nil;
+		}
+		async_queued--;
+		pthread_mutex_unlock(&async_mu);
+
+		// fn is a cgo wrapper, which returns an int32 errno
+		// or nothing; in the latter case the Go side ignores ret.
+		c->ret = c->fn(c->arg);
+
+		// Push c on the done list. The runtime takes the whole
+		// list when woken, so only the first push needs to
+		// wake it.
+		old = __atomic_load_n(async_done, __ATOMIC_RELAXED);
+		do {
+			c->next = (struct cgo_async_call*)old;
+		} while (!__atomic_compare_exchange_n(async_done, &old, (uintptr_t)c, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+		if (old == 0) {
+			b = 0;
+			while (write(async_wfd, &b, 1) < 0 && errno == EINTR) {
+			}
+		}
+
+		pthread_mutex_lock(&async_mu);
+	}
+	return nil;
+}
+
+// async_start_worker starts a worker thread. Go's signals are handled
+// on Go threads, so the worker blocks them all. Called with async_mu
+// held.
+static void
+async_start_worker(void) {
+	pthread_t p;
+	sigset_t ign, oset;
+	int err;
+
+	sigfillset(&ign);
+	pthread_sigmask(SIG_SETMASK, &ign, &oset);
+	err = _cgo_try_pthread_create(&p, nil, async_worker, nil);
+	pthread_sigmask(SIG_SETMASK, &oset, nil);
+
+	if (err != 0) {
+		// The calls wait for the existing workers, if any.
+		if (async_threads > 0) {
+			return;
+		}
+		fprintf(stderr, "runtime/cgo: pthread_create failed: %s\n", strerror(err));
+		abort();
+	}
+	async_threads++;
+}
+
+// x_cgo_async_init creates the pipe used to wake the runtime when
+// calls are done. It is called once, before the first call.
+void
+x_cgo_async_init(void *v) {
+	struct cgo_async_init *a;
+	int fds[2];
+	int i;
+
+	a = (struct cgo_async_init*)v;
+	a->fd = -1;
+	if (pipe(fds) < 0) {
+		return;
+	}
+	for (i = 0; i < 2; i++) {
+		fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+		fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+	}
+	async_max = a->threads;
+	async_done = a->done;
+	async_wfd = fds[1];
+	a->fd = fds[0];
+}
+
+// x_cgo_async_submit queues a call for the workers, starting a new
+// worker if all are busy and the pool is not full. It is called on
+// the g0 stack after the calling goroutine has parked.
+void
+x_cgo_async_submit(void *v) {
+	struct cgo_async_call *c;
+
+	c = (struct cgo_async_call*)v;
+	c->next = nil;
+
+	pthread_mutex_lock(&async_mu);
+	if (async_tail == nil) {
+		async_head = c;
+	} else {
+		async_tail->next = c;
+	}
+	async_tail = c;
+	async_queued++;
+	if (async_queued > async_idle && async_threads < async_max) {
+		async_start_worker();
+	}
+	pthread_cond_signal(&async_cond);
+	pthread_mutex_unlock(&async_mu);
+}
@@ -11,8 +11,11 @@
 void _cgo_release_context(uintptr_t ctxt) {
 	void (*pfn)(struct context_arg*);
 
+	if (ctxt == 0) {
+		return;
+	}
 	pfn = _cgo_get_context_function();
-	if (ctxt != 0 && pfn != nil) {
+	if (pfn != nil) {
 		struct context_arg arg;
 
 		arg.Context = ctxt;
@@ -18,11 +18,17 @@ static pthread_cond_t runtime_init_cond = PTHREAD_COND_INITIALIZER;
 static pthread_mutex_t runtime_init_mu = PTHREAD_MUTEX_INITIALIZER;
 static int runtime_init_done;
 
+// With GODEBUG=cgolazyinit=1, the function that starts the Go runtime
+// of a c-archive or c-shared library and its argument, until the
+// runtime is started.
+static void* (*runtime_start_func)(void*);
+static void* runtime_start_arg;
+
 // The context function, used when tracing back C calls into Go.
 static void (*cgo_context_function)(struct context_arg*);
 
-void
-x_cgo_sys_thread_create(void* (*func)(void*), void* arg) {
+static void
+sys_thread_create(void* (*func)(void*), void* arg) {
 	pthread_t p;
 	int err = _cgo_try_pthread_create(&p, NULL, func, arg);
 	if (err != 0) {
@@ -31,13 +37,79 @@ x_cgo_sys_thread_create(void* (*func)(void*), void* arg) {
 	}
 }
 
+// lazy_init reports whether GODEBUG sets cgolazyinit=1.
+static int
+lazy_init(void) {
+	static const char key[] = "cgolazyinit=";
+	const char* s;
+	int lazy;
+
+	lazy = 0;
+	for (s = getenv("GODEBUG"); s != nil && *s != '\0'; s++) {
+		if (strncmp(s, key, sizeof key - 1) == 0) {
+			lazy = atoi(s + sizeof key - 1) != 0;
+		}
+		s = strchr(s, ',');
+		if (s == nil) {
+			break;
+		}
+	}
+	return lazy;
+}
+
+// x_cgo_sys_thread_create starts the thread that initializes the Go
+// runtime when a c-archive or c-shared library is loaded. With
+// GODEBUG=cgolazyinit=1 it only records the thread function; the
+// runtime is started by the first call into Go, or earlier by
+// _cgo_start_runtime.
+void
+x_cgo_sys_thread_create(void* (*func)(void*), void* arg) {
+	if (lazy_init()) {
+		pthread_mutex_lock(&runtime_init_mu);
+		runtime_start_func = func;
+		runtime_start_arg = arg;
+		pthread_mutex_unlock(&runtime_init_mu);
+		return;
+	}
+	sys_thread_create(func, arg);
+}
+
+// _cgo_start_runtime starts initializing the Go runtime of a library
+// loaded with GODEBUG=cgolazyinit=1 in the background, if that has
+// not started yet, and returns without waiting for it. Otherwise it
+// does nothing. A C program reaches it through the GoStartRuntime_
+// function that cmd/cgo writes for each package with an export
+// header, so that its first call into Go does not wait for package
+// initialization.
+void
+_cgo_start_runtime(void) {
+	void* (*func)(void*);
+	void* arg;
+
+	pthread_mutex_lock(&runtime_init_mu);
+	func = runtime_start_func;
+	arg = runtime_start_arg;
+	runtime_start_func = nil;
+	pthread_mutex_unlock(&runtime_init_mu);
+	if (func != nil) {
+		sys_thread_create(func, arg);
+	}
+}
+
 uintptr_t
 _cgo_wait_runtime_init_done() {
 	void (*pfn)(struct context_arg*);
 
-	pthread_mutex_lock(&runtime_init_mu);
-	while (runtime_init_done == 0) {
-		pthread_cond_wait(&runtime_init_cond, &runtime_init_mu);
+	// Every call from C into Go comes through here, so once the
+	// runtime is up avoid taking the lock.
+	if (__atomic_load_n(&runtime_init_done, __ATOMIC_ACQUIRE) == 0) {
+		_cgo_start_runtime();
+
+		pthread_mutex_lock(&runtime_init_mu);
+		while (runtime_init_done == 0) {
+			pthread_cond_wait(&runtime_init_cond, &runtime_init_mu);
+		}
+		pthread_mutex_unlock(&runtime_init_mu);
 	}
 
 	// TODO(iant): For the case of a new C thread calling into Go, such
@@ -49,9 +121,8 @@ _cgo_wait_runtime_init_done() {
 	// initialization to be complete anyhow, later, by waiting for
 	// main_init_done to be closed in cgocallbackg1. We should wait here
 	// instead. See also issue #15943.
-	pfn = cgo_context_function;
+	pfn = __atomic_load_n(&cgo_context_function, __ATOMIC_ACQUIRE);
 
-	pthread_mutex_unlock(&runtime_init_mu);
 	if (pfn != nil) {
 		struct context_arg arg;
 
@@ -65,7 +136,7 @@ _cgo_wait_runtime_init_done() {
 void
 x_cgo_notify_runtime_init_done(void* dummy) {
 	pthread_mutex_lock(&runtime_init_mu);
-	runtime_init_done = 1;
+	__atomic_store_n(&runtime_init_done, 1, __ATOMIC_RELEASE);
 	pthread_cond_broadcast(&runtime_init_cond);
 	pthread_mutex_unlock(&runtime_init_mu);
 }
@@ -74,18 +145,13 @@ x_cgo_notify_runtime_init_done(void* dummy) {
 // when calling a Go function from C code. Called from runtime.SetCgoTraceback.
 void x_cgo_set_context_function(void (*context)(struct context_arg*)) {
 	pthread_mutex_lock(&runtime_init_mu);
-	cgo_context_function = context;
+	__atomic_store_n(&cgo_context_function, context, __ATOMIC_RELEASE);
 	pthread_mutex_unlock(&runtime_init_mu);
 }
 
 // Gets the context function.
 void (*(_cgo_get_context_function(void)))(struct context_arg*) {
-	void (*ret)(struct context_arg*);
-
-	pthread_mutex_lock(&runtime_init_mu);
-	ret = cgo_context_function;
-	pthread_mutex_unlock(&runtime_init_mu);
-	return ret;
+	return __atomic_load_n(&cgo_context_function, __ATOMIC_ACQUIRE);
 }
 
 // _cgo_try_pthread_create retries pthread_create if it fails with
@@ -60,6 +60,12 @@ x_cgo_sys_thread_create(void (*func)(void*), void* arg) {
 	}
 }
 
+// GODEBUG=cgolazyinit=1 is not supported on Windows: the runtime is
+// always started when the library is loaded.
+void
+_cgo_start_runtime(void) {
+}
+
 int
 _cgo_is_runtime_initialized() {
 	 EnterCriticalSection(&runtime_init_cs);
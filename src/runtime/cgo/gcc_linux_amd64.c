@@ -89,10 +89,9 @@ threadentry(void *v)
 
 	ThreadStart ts;
 
+	_cgo_tsan_acquire_obj(v);
 	ts = *(ThreadStart*)v;
-	_cgo_tsan_acquire();
 	free(v);
-	_cgo_tsan_release();
 
 	/*
 	 * Set specific keys.
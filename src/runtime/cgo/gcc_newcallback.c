@@ -0,0 +1,79 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// +build cgo
+// +build darwin dragonfly freebsd linux netbsd openbsd solaris
+
+// C function pointers handed out by NewCallback. See cgocallback.go in
+// the runtime.
+
+#include "libcgo.h"
+
+// Keep in sync with cgoCallbackMax in cgocallback.go.
+#define CALLBACKS 1000
+
+// Keep in sync with cgoCallbackFrame in cgocallback.go.
+struct cgo_callback_frame {
+	uintptr_t index;
+	uintptr_t args[6];
+	uintptr_t ret;
+};
+
+extern void crosscall2(void (*fn)(void *, int, __SIZE_TYPE__), void *, int, __SIZE_TYPE__);
+extern void _cgo_callback(void *, int, __SIZE_TYPE__);
+extern void _cgo_release_context(__SIZE_TYPE__);
+
+// Not inlined, and taking the index last so that the arguments stay in
+// place, to keep each of the callbacks below a few instructions.
+static uintptr_t __attribute__((noinline))
+callback(uintptr_t a0, uintptr_t a1, uintptr_t a2, uintptr_t a3, uintptr_t a4, uintptr_t a5, uintptr_t index) {
+	__SIZE_TYPE__ ctxt;
+	struct cgo_callback_frame f;
+	struct {
+		struct cgo_callback_frame *f;
+	} a;
+
+	ctxt = _cgo_wait_runtime_init_done();
+	f.index = index;
+	f.args[0] = a0;
+	f.args[1] = a1;
+	f.args[2] = a2;
+	f.args[3] = a3;
+	f.args[4] = a4;
+	f.args[5] = a5;
+	f.ret = 0;
+	a.f = &f;
+	crosscall2(_cgo_callback, &a, sizeof a, ctxt);
+	if (ctxt != 0) {
+		_cgo_release_context(ctxt);
+	}
+	return f.ret;
+}
+
+// Each callback passes its index in x_cgo_callbacks along with up to
+// six integer or pointer arguments. A caller passing fewer leaves the
+// rest undefined, which the Go side ignores; the C calling conventions
+// of the supported systems allow that.
+#define R10(F, n, i) \
+	F(n##0, (i)*10+0) F(n##1, (i)*10+1) F(n##2, (i)*10+2) F(n##3, (i)*10+3) F(n##4, (i)*10+4) \
+	F(n##5, (i)*10+5) F(n##6, (i)*10+6) F(n##7, (i)*10+7) F(n##8, (i)*10+8) F(n##9, (i)*10+9)
+#define R100(F, n, i) \
+	R10(F, n##0, (i)*10+0) R10(F, n##1, (i)*10+1) R10(F, n##2, (i)*10+2) R10(F, n##3, (i)*10+3) R10(F, n##4, (i)*10+4) \
+	R10(F, n##5, (i)*10+5) R10(F, n##6, (i)*10+6) R10(F, n##7, (i)*10+7) R10(F, n##8, (i)*10+8) R10(F, n##9, (i)*10+9)
+#define R1000(F, n) \
+	R100(F, n##0, 0) R100(F, n##1, 1) R100(F, n##2, 2) R100(F, n##3, 3) R100(F, n##4, 4) \
+	R100(F, n##5, 5) R100(F, n##6, 6) R100(F, n##7, 7) R100(F, n##8, 8) R100(F, n##9, 9)
+
+#define CALLBACK(n, i) \
+	static uintptr_t \
+	callback##n(uintptr_t a0, uintptr_t a1, uintptr_t a2, uintptr_t a3, uintptr_t a4, uintptr_t a5) { \
+		return callback(a0, a1, a2, a3, a4, a5, i); \
+	}
+#define ENTRY(n, i) (void*)callback##n,
+
+R1000(CALLBACK, _)
+
+void *x_cgo_callbacks[CALLBACKS] = {
+	R1000(ENTRY, _)
+};
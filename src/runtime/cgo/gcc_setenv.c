@@ -8,6 +8,7 @@
 #include "libcgo.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 /* Stub for calling setenv */
 void
@@ -26,3 +27,186 @@ x_cgo_unsetenv(char *arg)
 	unsetenv(arg);
 	_cgo_tsan_release();
 }
+
+// Keep in sync with cgoUpdateEnv in env_posix.go.
+struct cgo_updateenv {
+	char **set;	// "key=value" strings
+	uintptr_t nset;
+	char **unset;	// keys
+	uintptr_t nunset;
+};
+
+struct update {
+	const char *key;
+	size_t keylen;
+	char *kv;	// copy of the "key=value" string, or nil to unset
+	int done;	// the key is in the new environ
+	int used;	// kv is in the new environ
+};
+
+#ifdef __APPLE__
+#include <crt_externs.h>
+#define environ (*_NSGetEnviron())
+#else
+extern char **environ;
+#endif
+
+// The environ array that x_cgo_updateenv made last, if any, and the
+// number of entries it has room for, including the terminating nil.
+static char **own_environ;
+static size_t own_cap;
+
+static size_t
+keylen(const char *s)
+{
+	const char *p;
+
+	for (p = s; *p != '\0' && *p != '='; p++) {
+	}
+	return p - s;
+}
+
+static size_t
+hashkey(const char *s, size_t n)
+{
+	size_t h, i;
+
+	h = 2166136261u;
+	for (i = 0; i < n; i++) {
+		h = (h ^ (unsigned char)s[i]) * 16777619u;
+	}
+	return h;
+}
+
+// lookup returns the slot for the key s[:n] in the table t of size
+// mask+1, which is either the slot holding it or an empty one.
+static struct update*
+lookup(struct update *t, size_t mask, const char *s, size_t n)
+{
+	size_t i;
+
+	for (i = hashkey(s, n) & mask; t[i].key != nil; i = (i + 1) & mask) {
+		if (t[i].keylen == n && memcmp(t[i].key, s, n) == 0) {
+			break;
+		}
+	}
+	return &t[i];
+}
+
+/*
+ * Applies the unsets and then the sets in arg to the environment in
+ * one pass over environ, rather than calling unsetenv and setenv for
+ * each, which scan environ each time. As libc does with its own
+ * array, the pass rewrites the environ array that a previous call
+ * made in place if it has room, and otherwise builds a larger one,
+ * growing it geometrically, and frees the old one. A string for a
+ * variable that already has the value is not copied again; the new
+ * strings are never freed, as with putenv. On allocation failure the
+ * environment is left alone, as setenv would.
+ *
+ * libc's environment lock is not exported, so this cannot take it:
+ * C code must not change the environment at the same time.
+ */
+void
+x_cgo_updateenv(struct cgo_updateenv *arg)
+{
+	struct update *t, *u;
+	size_t mask, n, i, j, kl, cap;
+	char **env, **e, **old;
+
+	for (mask = 15; mask < 2*(arg->nset + arg->nunset); mask = 2*mask + 1) {
+	}
+	t = calloc(mask + 1, sizeof t[0]);
+	if (t == nil) {
+		return;
+	}
+	for (i = 0; i < arg->nunset; i++) {
+		kl = keylen(arg->unset[i]);
+		if (kl == 0 || arg->unset[i][kl] != '\0') {
+			continue; // not a valid key, as for unsetenv
+		}
+		u = lookup(t, mask, arg->unset[i], kl);
+		u->key = arg->unset[i];
+		u->keylen = kl;
+	}
+	for (i = 0; i < arg->nset; i++) {
+		kl = keylen(arg->set[i]);
+		u = lookup(t, mask, arg->set[i], kl);
+		u->key = arg->set[i];
+		u->keylen = kl;
+		u->kv = strdup(arg->set[i]);
+		if (u->kv == nil) {
+			goto out;
+		}
+	}
+
+	_cgo_tsan_acquire();
+	n = 0;
+	if (environ != nil) {
+		for (e = environ; *e != nil; e++) {
+			n++;
+		}
+	}
+	cap = n + arg->nset + 1;
+	if (environ == own_environ && cap <= own_cap) {
+		// Compact in place: each entry is written no later
+		// than it is read.
+		env = own_environ;
+		cap = own_cap;
+	} else {
+		if (cap < 2*own_cap) {
+			cap = 2*own_cap;
+		}
+		env = malloc(cap * sizeof env[0]);
+		if (env == nil) {
+			_cgo_tsan_release();
+			goto out;
+		}
+	}
+	j = 0;
+	for (i = 0; i < n; i++) {
+		u = lookup(t, mask, environ[i], keylen(environ[i]));
+		if (u->key == nil) {
+			env[j++] = environ[i];
+		} else if (u->kv != nil && !u->done) {
+			// Replace the first occurrence of the key, and drop
+			// any others, which Go ignores too. Keep the old
+			// string if it already has the value, so that
+			// repeating a change does not leak a copy.
+			if (strcmp(environ[i], u->kv) == 0) {
+				env[j++] = environ[i];
+			} else {
+				env[j++] = u->kv;
+				u->used = 1;
+			}
+			u->done = 1;
+		}
+	}
+	for (i = 0; i < arg->nset; i++) {
+		u = lookup(t, mask, arg->set[i], keylen(arg->set[i]));
+		if (!u->done) {
+			env[j++] = u->kv;
+			u->used = 1;
+			u->done = 1;
+		}
+	}
+	env[j] = nil;
+	if (env != own_environ) {
+		// If environ is no longer our array, libc has
+		// replaced it with a copy of its own.
+		old = own_environ;
+		environ = env;
+		own_environ = env;
+		own_cap = cap;
+		free(old);
+	}
+	_cgo_tsan_release();
+
+out:
+	for (i = 0; i <= mask; i++) {
+		if (!t[i].used) {
+			free(t[i].kv);
+		}
+	}
+	free(t);
+}
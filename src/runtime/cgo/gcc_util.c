@@ -11,14 +11,14 @@ x_cgo_thread_start(ThreadStart *arg)
 	ThreadStart *ts;
 
 	/* Make our own copy that can persist after we return. */
-	_cgo_tsan_acquire();
 	ts = malloc(sizeof *ts);
-	_cgo_tsan_release();
 	if(ts == nil) {
 		fprintf(stderr, "runtime/cgo: out of memory in thread_start\n");
 		abort();
 	}
 	*ts = *arg;
+	/* Hand ts to the new thread, which frees it. */
+	_cgo_tsan_release_obj(ts);
 
 	_cgo_sys_thread_start(ts);	/* OS-dependent half */
 }
@@ -143,9 +143,28 @@ static void _cgo_tsan_release() {
 	__tsan_release(&_cgo_sync);
 }
 
+// _cgo_tsan_acquire_obj and _cgo_tsan_release_obj synchronize on the
+// object at p instead of on _cgo_sync, for memory that is handed from
+// one thread to another and is never seen by user C code. Every thread
+// synchronizing on _cgo_sync serializes TSAN's clock updates, so the
+// global object is used only where user C code may observe the effects
+// of the call, as for mmap, setenv and sigaction.
+
+__attribute__ ((unused))
+static void _cgo_tsan_acquire_obj(void *p) {
+	__tsan_acquire(p);
+}
+
+__attribute__ ((unused))
+static void _cgo_tsan_release_obj(void *p) {
+	__tsan_release(p);
+}
+
 #else // !defined(CGO_TSAN)
 
 #define _cgo_tsan_acquire()
 #define _cgo_tsan_release()
+#define _cgo_tsan_acquire_obj(p)
+#define _cgo_tsan_release_obj(p)
 
 #endif // !defined(CGO_TSAN)
@@ -0,0 +1,50 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// +build darwin dragonfly freebsd linux netbsd openbsd solaris
+
+package cgo
+
+import "unsafe"
+
+//go:cgo_import_static x_cgo_callbacks
+//go:linkname x_cgo_callbacks x_cgo_callbacks
+//go:linkname _cgo_callbacks runtime._cgo_callbacks
+var x_cgo_callbacks byte
+var _cgo_callbacks = &x_cgo_callbacks
+
+// Call like this in code compiled with gcc:
+//   struct { struct cgo_callback_frame *f; } a;
+//   crosscall2(_cgo_callback, &a, sizeof a, ctxt);
+
+//go:linkname _runtime_cgo_callback_internal runtime._cgo_callback_internal
+var _runtime_cgo_callback_internal byte
+
+//go:linkname _cgo_callback _cgo_callback
+//go:cgo_export_static _cgo_callback
+//go:nosplit
+//go:norace
+func _cgo_callback(a unsafe.Pointer, n int32, ctxt uintptr) {
+	_runtime_cgocallback(unsafe.Pointer(&_runtime_cgo_callback_internal), a, uintptr(n), ctxt)
+}
+
+// Provided by package runtime.
+func runtime_cgoNewCallback(fn interface{}) uintptr
+
+// NewCallback returns a C function pointer that calls the Go function
+// fn, for C APIs that take a callback, such as qsort. fn must take at
+// most six arguments and return one result, each of an integer or
+// pointer type the size of a pointer, such as uintptr, unsafe.Pointer
+// or int. Floating-point, complex and other types are rejected. The C
+// caller may pass values of C integer and pointer types, and sees the
+// result as an integer or a pointer.
+//
+// A C call through the pointer is a call from C to Go like a call to
+// an exported Go function, and the same rules apply. Only a limited
+// number of callbacks can be created, and their memory is never
+// released, but calling NewCallback again with the same func value
+// returns the same pointer.
+func NewCallback(fn interface{}) uintptr {
+	return runtime_cgoNewCallback(fn)
+}
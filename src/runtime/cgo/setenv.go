@@ -19,3 +19,9 @@ var _cgo_setenv = &x_cgo_setenv
 //go:linkname _cgo_unsetenv runtime._cgo_unsetenv
 var x_cgo_unsetenv byte
 var _cgo_unsetenv = &x_cgo_unsetenv
+
+//go:cgo_import_static x_cgo_updateenv
+//go:linkname x_cgo_updateenv x_cgo_updateenv
+//go:linkname _cgo_updateenv runtime._cgo_updateenv
+var x_cgo_updateenv byte
+var _cgo_updateenv = &x_cgo_updateenv
@@ -0,0 +1,170 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// +build darwin dragonfly freebsd linux netbsd openbsd solaris
+
+// Asynchronous cgo calls.
+//
+// A call to a C function marked with a #cgo async directive does not
+// occupy an M while the C function runs. The calling goroutine parks,
+// and the call runs on one of a bounded pool of C worker threads
+// managed by runtime/cgo (gcc_async.c). A worker pushes the finished
+// call on cgoAsync.done and, if the list was empty, writes a byte to
+// a pipe watched by the netpoller. cgoAsyncPoller, a runtime goroutine
+// blocked on that pipe like any network read, then readies the
+// callers. Thousands of goroutines may thus wait for slow C calls
+// using only the worker threads.
+//
+// The C function runs on a thread that is not the caller's, so a
+// goroutine locked to its thread makes an ordinary cgo call instead.
+// The arguments are in the caller's frame, which C writes the results
+// to, so the stack of a goroutine parked in an asynchronous call is
+// not shrunk (see shrinkstack).
+
+package runtime
+
+import (
+	"runtime/internal/atomic"
+	"unsafe"
+)
+
+// Filled in by runtime/cgo on systems that support asynchronous calls.
+var (
+	_cgo_async_init   unsafe.Pointer
+	_cgo_async_submit unsafe.Pointer
+)
+
+// cgoAsyncDefaultThreads is the default size of the worker pool,
+// which GODEBUG=cgoasyncthreads=N overrides.
+const cgoAsyncDefaultThreads = 16
+
+// cgoAsyncCall is an asynchronous call in progress. It is struct
+// cgo_async_call in gcc_async.c.
+type cgoAsyncCall struct {
+	fn   unsafe.Pointer
+	arg  unsafe.Pointer
+	gp   guintptr
+	next uintptr // *cgoAsyncCall; linked by C
+	ret  int32
+}
+
+// cgoAsyncInitArgs is struct cgo_async_init in gcc_async.c.
+type cgoAsyncInitArgs struct {
+	threads int32    // maximum number of worker threads
+	fd      int32    // set by C: read end of the wakeup pipe, or -1
+	done    *uintptr // where C pushes finished calls
+}
+
+var cgoAsync struct {
+	lock  mutex
+	state uint32   // cgoAsyncUnstarted, cgoAsyncOn, or cgoAsyncOff
+	done  uintptr  // *cgoAsyncCall list of finished calls, pushed by C
+	buf   [64]byte // for draining the wakeup pipe in cgoAsyncPoller
+}
+
+const (
+	cgoAsyncUnstarted = iota
+	cgoAsyncOn
+	cgoAsyncOff
+)
+
+// cgocallasync calls fn(arg) on a C worker thread while the calling
+// goroutine is parked, and returns what fn returns. It falls back to
+// cgocall where that is not possible.
+func cgocallasync(fn, arg unsafe.Pointer) int32 {
+	gp := getg()
+	if gp.lockedm != 0 || !cgoAsyncStart() {
+		return cgocall(fn, arg)
+	}
+
+	if raceenabled {
+		racereleasemerge(unsafe.Pointer(&racecgosync))
+	}
+
+	c := &cgoAsyncCall{fn: fn, arg: arg}
+	c.gp.set(gp)
+	gp.m.ncgocall++
+	gopark(cgoAsyncSubmit, unsafe.Pointer(c), waitReasonCgoAsync, traceEvGoBlock, 1)
+
+	if raceenabled {
+		raceacquire(unsafe.Pointer(&racecgosync))
+	}
+	return c.ret
+}
+
+// cgoAsyncSubmit hands c to the workers once its goroutine is parked,
+// so that a worker can ready it as soon as the call is done.
+func cgoAsyncSubmit(gp *g, c unsafe.Pointer) bool {
+	asmcgocall(_cgo_async_submit, c)
+	return true
+}
+
+// cgoAsyncStart sets up the worker pool and its poller on first use,
+// and reports whether asynchronous calls are available.
+func cgoAsyncStart() bool {
+	if s := atomic.Load(&cgoAsync.state); s != cgoAsyncUnstarted {
+		return s == cgoAsyncOn
+	}
+	if _cgo_async_init == nil {
+		atomic.Store(&cgoAsync.state, cgoAsyncOff)
+		return false
+	}
+
+	var pd *pollDesc
+	args := cgoAsyncInitArgs{
+		threads: debug.cgoasyncthreads,
+		done:    &cgoAsync.done,
+	}
+	if args.threads <= 0 {
+		args.threads = cgoAsyncDefaultThreads
+	}
+
+	lock(&cgoAsync.lock)
+	if cgoAsync.state == cgoAsyncUnstarted {
+		state := uint32(cgoAsyncOff)
+		asmcgocall(_cgo_async_init, unsafe.Pointer(&args))
+		if args.fd >= 0 {
+			netpollGenericInit()
+			var errno int
+			pd, errno = poll_runtime_pollOpen(uintptr(args.fd))
+			if errno == 0 {
+				state = cgoAsyncOn
+			} else {
+				poll_runtime_pollUnblock(pd)
+				poll_runtime_pollClose(pd)
+				closefd(args.fd)
+				pd = nil
+			}
+		}
+		atomic.Store(&cgoAsync.state, state)
+	}
+	unlock(&cgoAsync.lock)
+
+	if pd != nil {
+		go cgoAsyncPoller(pd, args.fd)
+	}
+	return atomic.Load(&cgoAsync.state) == cgoAsyncOn
+}
+
+// cgoAsyncPoller readies the goroutines whose asynchronous calls have
+// finished, waiting for more in the netpoller.
+func cgoAsyncPoller(pd *pollDesc, fd int32) {
+	for {
+		// Reset before draining the pipe, so that a byte written
+		// after the drain is not lost.
+		poll_runtime_pollReset(pd, 'r')
+		for read(fd, unsafe.Pointer(&cgoAsync.buf[0]), int32(len(cgoAsync.buf))) > 0 {
+		}
+
+		// The caller's stack keeps c alive until it is readied.
+		c := (*cgoAsyncCall)(unsafe.Pointer(atomic.Xchguintptr(&cgoAsync.done, 0)))
+		for c != nil {
+			next := (*cgoAsyncCall)(unsafe.Pointer(c.next))
+			goready(c.gp.ptr(), 0)
+			c = next
+		}
+
+		poll_runtime_pollWait(pd, 'r')
+	}
+}
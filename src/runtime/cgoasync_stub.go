@@ -0,0 +1,15 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+// +build !darwin,!dragonfly,!freebsd,!linux,!netbsd,!openbsd,!solaris
+
+package runtime
+
+import "unsafe"
+
+// cgocallasync is cgocall on systems without asynchronous cgo calls.
+// See cgoasync.go.
+func cgocallasync(fn, arg unsafe.Pointer) int32 {
+	return cgocall(fn, arg)
+}
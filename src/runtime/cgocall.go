@@ -100,16 +100,7 @@ func cgocall(fn, arg unsafe.Pointer) int32 {
 		throw("cgocall nil")
 	}
 
-	if raceenabled {
-		racereleasemerge(unsafe.Pointer(&racecgosync))
-	}
-
-	mp := getg().m
-	mp.ncgocall++
-	mp.ncgo++
-
-	// Reset traceback.
-	mp.cgoCallers[0] = 0
+	mp := startcgo()
 
 	// Announce we are entering a system call
 	// so that the scheduler knows to create another
@@ -153,6 +144,56 @@ func cgocall(fn, arg unsafe.Pointer) int32 {
 	return errno
 }
 
+// Call from Go to a C function that is expected to block for a long
+// time, marked with a #cgo blocking directive. Unlike cgocall, which
+// leaves the P to be retaken by sysmon if the call takes a while,
+// cgocallblock hands off the P to another M right away, so that other
+// goroutines can run while the call blocks. That costs a thread
+// switch, which is wasted if the call turns out to be short.
+//go:nosplit
+func cgocallblock(fn, arg unsafe.Pointer) int32 {
+	if !iscgo && GOOS != "solaris" && GOOS != "windows" {
+		throw("cgocall unavailable")
+	}
+
+	if fn == nil {
+		throw("cgocall nil")
+	}
+
+	mp := startcgo()
+
+	// See cgocall.
+	entersyscallblock()
+
+	mp.incgo = true
+	errno := asmcgocall(fn, arg)
+
+	endcgo(mp)
+
+	exitsyscall()
+
+	KeepAlive(fn)
+	KeepAlive(arg)
+	KeepAlive(mp)
+
+	return errno
+}
+
+//go:nosplit
+func startcgo() *m {
+	if raceenabled {
+		racereleasemerge(unsafe.Pointer(&racecgosync))
+	}
+
+	mp := getg().m
+	mp.ncgocall++
+	mp.ncgo++
+
+	// Reset traceback.
+	mp.cgoCallers[0] = 0
+	return mp
+}
+
 //go:nosplit
 func endcgo(mp *m) {
 	mp.incgo = false
@@ -405,8 +446,11 @@ var racecgosync uint64 // represents possible synchronization in C code
 // also have to change to pin Go pointers that cannot point to Go
 // pointers.)
 
+// A Go pointer stored in Go memory is allowed if the object it points
+// to has been pinned with a Pinner; see pinner.go.
+
 // cgoCheckPointer checks if the argument contains a Go pointer that
-// points to a Go pointer, and panics if it does.
+// points to an unpinned Go pointer, and panics if it does.
 func cgoCheckPointer(ptr interface{}, args ...interface{}) {
 	if debug.cgocheck == 0 {
 		return
@@ -510,7 +554,7 @@ func cgoCheckArg(t *_type, p unsafe.Pointer, indir, top bool, msg string) {
 		if !cgoIsGoPointer(p) {
 			return
 		}
-		if !top {
+		if !top && !isPinned(p) {
 			panic(errorString(msg))
 		}
 		cgoCheckArg(it, p, it.kind&kindDirectIface == 0, false, msg)
@@ -521,7 +565,7 @@ func cgoCheckArg(t *_type, p unsafe.Pointer, indir, top bool, msg string) {
 		if !cgoIsGoPointer(p) {
 			return
 		}
-		if !top {
+		if !top && !isPinned(p) {
 			panic(errorString(msg))
 		}
 		if st.elem.kind&kindNoPointers != 0 {
@@ -536,7 +580,7 @@ func cgoCheckArg(t *_type, p unsafe.Pointer, indir, top bool, msg string) {
 		if !cgoIsGoPointer(ss.str) {
 			return
 		}
-		if !top {
+		if !top && !isPinned(ss.str) {
 			panic(errorString(msg))
 		}
 	case kindStruct:
@@ -559,7 +603,7 @@ func cgoCheckArg(t *_type, p unsafe.Pointer, indir, top bool, msg string) {
 		if !cgoIsGoPointer(p) {
 			return
 		}
-		if !top {
+		if !top && !isPinned(p) {
 			panic(errorString(msg))
 		}
 
@@ -585,8 +629,10 @@ func cgoCheckUnknownPointer(p unsafe.Pointer, msg string) (base, i uintptr) {
 				// No more possible pointers.
 				break
 			}
-			if hbits.isPointer() && cgoIsGoPointer(*(*unsafe.Pointer)(unsafe.Pointer(base + i))) {
-				panic(errorString(msg))
+			if hbits.isPointer() {
+				if v := *(*unsafe.Pointer)(unsafe.Pointer(base + i)); cgoIsGoPointer(v) && !isPinned(v) {
+					panic(errorString(msg))
+				}
 			}
 			hbits = hbits.next()
 		}
@@ -4,6 +4,11 @@
 
 package runtime
 
+import (
+	"runtime/internal/sys"
+	"unsafe"
+)
+
 // These functions are called from C code via cgo/callbacks.go.
 
 // Panic.
@@ -11,3 +16,119 @@ package runtime
 func _cgo_panic_internal(p *byte) {
 	panic(gostringnocopy(p))
 }
+
+// C function pointers bound to Go functions, handed out by NewCallback
+// in runtime/cgo. runtime/cgo (gcc_newcallback.c) fills in
+// _cgo_callbacks with a table of C functions that each call
+// _cgo_callback_internal through crosscall2, passing their index in
+// the table and their arguments.
+
+// Filled in by runtime/cgo when available.
+var _cgo_callbacks unsafe.Pointer
+
+// cgoCallbackMax is the number of entries in _cgo_callbacks. Keep in
+// sync with CALLBACKS in gcc_newcallback.c.
+const cgoCallbackMax = 1000
+
+// cgoCallbackFrame is struct cgo_callback_frame in gcc_newcallback.c.
+type cgoCallbackFrame struct {
+	index uintptr
+	args  [6]uintptr
+	ret   uintptr
+}
+
+type cgoCallback struct {
+	fn    unsafe.Pointer // *funcval
+	nargs int
+}
+
+var cgoCallbacks struct {
+	lock mutex
+	fns  [cgoCallbackMax]cgoCallback
+	n    int
+}
+
+//go:linkname cgoNewCallback runtime/cgo.runtime_cgoNewCallback
+func cgoNewCallback(fn interface{}) uintptr {
+	if _cgo_callbacks == nil {
+		panic("NewCallback: not supported on " + GOOS + " or without cgo")
+	}
+	e := efaceOf(&fn)
+	if e._type == nil || e._type.kind&kindMask != kindFunc {
+		panic("NewCallback: expected function with one pointer-sized integer or pointer result")
+	}
+	ft := (*functype)(unsafe.Pointer(e._type))
+	if len(ft.out()) != 1 || !cgoCallbackWord(ft.out()[0]) {
+		panic("NewCallback: expected function with one pointer-sized integer or pointer result")
+	}
+	if len(ft.in()) > len(cgoCallbackFrame{}.args) {
+		panic("NewCallback: more than six arguments")
+	}
+	for _, t := range ft.in() {
+		if !cgoCallbackWord(t) {
+			panic("NewCallback: argument is not a pointer-sized integer or pointer")
+		}
+	}
+	if e.data == nil {
+		panic("NewCallback: nil function")
+	}
+
+	lock(&cgoCallbacks.lock)
+	defer unlock(&cgoCallbacks.lock)
+
+	i := 0
+	for ; i < cgoCallbacks.n; i++ {
+		if cgoCallbacks.fns[i].fn == e.data {
+			break
+		}
+	}
+	if i == cgoCallbacks.n {
+		if i == cgoCallbackMax {
+			panic("NewCallback: too many callbacks")
+		}
+		cgoCallbacks.fns[i] = cgoCallback{e.data, len(ft.in())}
+		cgoCallbacks.n++
+	}
+	return *(*uintptr)(add(_cgo_callbacks, uintptr(i)*sys.PtrSize))
+}
+
+// cgoCallbackWord reports whether values of type t are passed in a
+// single integer register by the C calling convention, as the
+// trampolines in gcc_newcallback.c assume: integers and pointers the
+// size of a pointer. Floating-point values use other registers.
+func cgoCallbackWord(t *_type) bool {
+	if t.size != sys.PtrSize {
+		return false
+	}
+	switch t.kind & kindMask {
+	case kindInt, kindInt8, kindInt16, kindInt32, kindInt64,
+		kindUint, kindUint8, kindUint16, kindUint32, kindUint64, kindUintptr,
+		kindPtr, kindUnsafePointer:
+		return true
+	}
+	return false
+}
+
+// Call.
+
+func _cgo_callback_internal(f *cgoCallbackFrame) {
+	c := &cgoCallbacks.fns[f.index]
+	a := &f.args
+	fn := c.fn
+	switch c.nargs {
+	case 0:
+		f.ret = (*(*func() uintptr)(unsafe.Pointer(&fn)))()
+	case 1:
+		f.ret = (*(*func(uintptr) uintptr)(unsafe.Pointer(&fn)))(a[0])
+	case 2:
+		f.ret = (*(*func(uintptr, uintptr) uintptr)(unsafe.Pointer(&fn)))(a[0], a[1])
+	case 3:
+		f.ret = (*(*func(uintptr, uintptr, uintptr) uintptr)(unsafe.Pointer(&fn)))(a[0], a[1], a[2])
+	case 4:
+		f.ret = (*(*func(uintptr, uintptr, uintptr, uintptr) uintptr)(unsafe.Pointer(&fn)))(a[0], a[1], a[2], a[3])
+	case 5:
+		f.ret = (*(*func(uintptr, uintptr, uintptr, uintptr, uintptr) uintptr)(unsafe.Pointer(&fn)))(a[0], a[1], a[2], a[3], a[4])
+	case 6:
+		f.ret = (*(*func(uintptr, uintptr, uintptr, uintptr, uintptr, uintptr) uintptr)(unsafe.Pointer(&fn)))(a[0], a[1], a[2], a[3], a[4], a[5])
+	}
+}
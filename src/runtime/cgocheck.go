@@ -43,12 +43,30 @@ func cgoCheckWriteBarrier(dst *uintptr, src uintptr) {
 		return
 	}
 
+	// A pinned object may be referred to from non-Go memory.
+	if cgoIsPinned(unsafe.Pointer(src)) {
+		return
+	}
+
 	systemstack(func() {
 		println("write of Go pointer", hex(src), "to non-Go memory", hex(uintptr(unsafe.Pointer(dst))))
 		throw(cgoWriteBarrierFail)
 	})
 }
 
+// cgoIsPinned reports whether the Go pointer p points into a pinned
+// object. It runs isPinned on the system stack, since it is called
+// from the nosplit write barrier checks.
+//go:nosplit
+//go:nowritebarrier
+func cgoIsPinned(p unsafe.Pointer) bool {
+	pinned := false
+	systemstack(func() {
+		pinned = isPinned(p)
+	})
+	return pinned
+}
+
 // cgoCheckMemmove is called when moving a block of memory.
 // dst and src point off bytes into the value to copy.
 // size is the number of bytes to copy.
@@ -147,7 +165,7 @@ func cgoCheckTypedBlock(typ *_type, src unsafe.Pointer, off, size uintptr) {
 		bits := hbits.bits()
 		if i >= off && bits&bitPointer != 0 {
 			v := *(*unsafe.Pointer)(add(src, i))
-			if cgoIsGoPointer(v) {
+			if cgoIsGoPointer(v) && !cgoIsPinned(v) {
 				throw(cgoWriteBarrierFail)
 			}
 		}
@@ -180,7 +198,7 @@ func cgoCheckBits(src unsafe.Pointer, gcbits *byte, off, size uintptr) {
 		} else {
 			if bits&1 != 0 {
 				v := *(*unsafe.Pointer)(add(src, i))
-				if cgoIsGoPointer(v) {
+				if cgoIsGoPointer(v) && !cgoIsPinned(v) {
 					throw(cgoWriteBarrierFail)
 				}
 			}
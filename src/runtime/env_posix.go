@@ -21,8 +21,9 @@ func gogetenv(key string) string {
 	return ""
 }
 
-var _cgo_setenv unsafe.Pointer   // pointer to C function
-var _cgo_unsetenv unsafe.Pointer // pointer to C function
+var _cgo_setenv unsafe.Pointer    // pointer to C function
+var _cgo_unsetenv unsafe.Pointer  // pointer to C function
+var _cgo_updateenv unsafe.Pointer // pointer to C function
 
 // Update the C environment if cgo is loaded.
 // Called from syscall.Setenv.
@@ -46,6 +47,57 @@ func syscall_unsetenv_c(k string) {
 	asmcgocall(_cgo_unsetenv, unsafe.Pointer(&arg))
 }
 
+// cgoUpdateEnv is struct cgo_updateenv in gcc_setenv.c.
+type cgoUpdateEnv struct {
+	set    *unsafe.Pointer
+	nset   uintptr
+	unset  *unsafe.Pointer
+	nunset uintptr
+}
+
+// Update the C environment if cgo is loaded, with one C call for all
+// the changes. set holds "key=value" strings.
+// Called from syscall.UpdateEnv.
+//go:linkname syscall_updateenv_c syscall.updateenv_c
+func syscall_updateenv_c(set, unset []string) {
+	if _cgo_updateenv == nil || len(set)+len(unset) == 0 {
+		return
+	}
+
+	// Copy the strings, NUL-terminated, into one buffer.
+	n := 0
+	for _, s := range set {
+		n += len(s) + 1
+	}
+	for _, s := range unset {
+		n += len(s) + 1
+	}
+	buf := make([]byte, n)
+	ptrs := make([]unsafe.Pointer, len(set)+len(unset))
+	n = 0
+	for i, s := range set {
+		ptrs[i] = unsafe.Pointer(&buf[n])
+		n += copy(buf[n:], s) + 1
+	}
+	for i, s := range unset {
+		ptrs[len(set)+i] = unsafe.Pointer(&buf[n])
+		n += copy(buf[n:], s) + 1
+	}
+
+	var arg cgoUpdateEnv
+	if len(set) > 0 {
+		arg.set = &ptrs[0]
+		arg.nset = uintptr(len(set))
+	}
+	if len(unset) > 0 {
+		arg.unset = &ptrs[len(set)]
+		arg.nunset = uintptr(len(unset))
+	}
+	asmcgocall(_cgo_updateenv, unsafe.Pointer(&arg))
+	KeepAlive(buf)
+	KeepAlive(ptrs)
+}
+
 func cstring(s string) unsafe.Pointer {
 	p := make([]byte, len(s)+1)
 	copy(p, s)
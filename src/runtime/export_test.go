@@ -472,3 +472,13 @@ func stackOverflow(x *byte) {
 	var buf [256]byte
 	stackOverflow(&buf[0])
 }
+
+func IsPinned(p unsafe.Pointer) bool {
+	return isPinned(p)
+}
+
+func SetPinnerLeakPanic(f func()) (old func()) {
+	old = pinnerLeakPanic
+	pinnerLeakPanic = f
+	return old
+}
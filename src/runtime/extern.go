@@ -27,6 +27,10 @@ It is a comma-separated list of name=val pairs setting these named variables:
 	allocfreetrace: setting allocfreetrace=1 causes every allocation to be
 	profiled and a stack trace printed on each object's allocation and free.
 
+	cgoasyncthreads: setting cgoasyncthreads=N limits the number of
+	threads that run calls to C functions marked with a #cgo async
+	directive. The default is 16.
+
 	cgocheck: setting cgocheck=0 disables all checks for packages
 	using cgo to incorrectly pass Go pointers to non-Go code.
 	Setting cgocheck=1 (the default) enables relatively cheap
@@ -34,6 +38,16 @@ It is a comma-separated list of name=val pairs setting these named variables:
 	expensive checks that should not miss any errors, but will
 	cause your program to run slower.
 
+	cgolazyinit: setting cgolazyinit=1 delays starting the runtime of
+	a library built with -buildmode=c-archive or -buildmode=c-shared
+	until the first call into Go, instead of starting it in the
+	background when the library is loaded. The C program can start it
+	earlier, without waiting for it, by calling GoStartRuntime_P, which
+	is declared in the header file generated for the library, where P
+	is the import path of the package with every character other than
+	a letter or digit replaced by an underscore. The setting is read
+	when the library is loaded, and is not supported on Windows.
+
 	efence: setting efence=1 causes the allocator to run in a mode
 	where each object is allocated on a unique page and addresses are
 	never recycled.
@@ -105,6 +119,14 @@ It is a comma-separated list of name=val pairs setting these named variables:
 	This should only be used as a temporary workaround to diagnose buggy code.
 	The real fix is to not store integers in pointer-typed locations.
 
+	racesample: in a program built with -race, setting racesample=N, with
+	0 < N < 100, makes the race detector check the memory accesses to only
+	about N percent of memory, chosen by address in 64-byte blocks. A data race
+	on a checked block is detected as usual; one elsewhere is missed. This
+	trades detection rate for speed, for running instrumented binaries on
+	production traffic. Synchronization, including that of cgo calls, is
+	always tracked, so sampling does not cause false reports.
+
 	sbrk: setting sbrk=1 replaces the memory allocator and garbage collector
 	with a trivial allocator that obtains memory from the operating system and
 	never reclaims any memory.
@@ -244,10 +244,13 @@ func (s *mspan) sweep(preserve bool) bool {
 				// (as opposed to object beginning).
 				p := s.base() + uintptr(special.offset)
 				if special.kind == _KindSpecialFinalizer || !hasFin {
-					// Splice out special record.
+					// Splice out special record. isPinned reads
+					// the list of an unswept span under the lock.
 					y := special
 					special = special.next
+					lock(&s.speciallock)
 					*specialp = special
+					unlock(&s.speciallock)
 					freespecial(y, unsafe.Pointer(p), size)
 				} else {
 					// This is profile record, but the object has finalizers (so kept alive).
@@ -77,15 +77,30 @@ type pollCache struct {
 }
 
 var (
-	netpollInited  uint32
-	pollcache      pollCache
-	netpollWaiters uint32
+	netpollInitLock mutex
+	netpollInited   uint32
+	pollcache       pollCache
+	netpollWaiters  uint32
 )
 
 //go:linkname poll_runtime_pollServerInit internal/poll.runtime_pollServerInit
 func poll_runtime_pollServerInit() {
-	netpollinit()
-	atomic.Store(&netpollInited, 1)
+	netpollGenericInit()
+}
+
+// netpollGenericInit initializes the netpoller if that has not been
+// done yet. The runtime uses the netpoller itself for asynchronous
+// cgo calls, so it may be initialized before package internal/poll
+// asks for it.
+func netpollGenericInit() {
+	if atomic.Load(&netpollInited) == 0 {
+		lock(&netpollInitLock)
+		if netpollInited == 0 {
+			netpollinit()
+			atomic.Store(&netpollInited, 1)
+		}
+		unlock(&netpollInitLock)
+	}
 }
 
 func netpollinited() bool {
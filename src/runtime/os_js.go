@@ -121,6 +121,7 @@ func setThreadCPUProfiler(hz int32)  {}
 func sigdisable(uint32)              {}
 func sigenable(uint32)               {}
 func sigignore(uint32)               {}
+func sigforward(uint32)              {}
 
 //go:linkname os_sigpipe os.sigpipe
 func os_sigpipe() {
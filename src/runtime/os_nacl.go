@@ -284,6 +284,7 @@ func setThreadCPUProfiler(hz int32)                       {}
 func sigdisable(uint32)                                   {}
 func sigenable(uint32)                                    {}
 func sigignore(uint32)                                    {}
+func sigforward(uint32)                                   {}
 func closeonexec(int32)                                   {}
 
 // gsignalStack is unused on nacl.
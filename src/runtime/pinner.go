@@ -0,0 +1,207 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+package runtime
+
+import "unsafe"
+
+// A Pinner is a set of pinned Go objects. An object pinned with Pin
+// stays at the same address and is not freed until the Unpin method
+// is called, so C code may keep pointers to it after the cgo call
+// that received them has returned, as asynchronous I/O interfaces
+// require.
+//
+// The zero value of a Pinner is ready to use. A Pinner that still
+// pins objects must not be discarded: if it becomes unreachable
+// before Unpin is called, the program panics.
+type Pinner struct {
+	*pinner
+}
+
+type pinner struct {
+	refs []unsafe.Pointer
+}
+
+// Pin pins the Go object that pointer points to, which must be a
+// pointer of any type or an unsafe.Pointer. An interior pointer pins
+// the whole object. An object may be pinned more than once, by one
+// Pinner or several; it stays pinned until each of them has been
+// unpinned.
+//
+// A pointer to a pinned object may be stored in C memory, and Go
+// memory passed to C may contain pointers to pinned objects; the
+// checks controlled by GODEBUG=cgocheck allow both. Pointers held in
+// a pinned object are not pinned along with it: the objects they
+// point to must be pinned as well if C code is going to follow them.
+//
+// Pin ignores pointers to memory not allocated from the Go heap,
+// such as global variables, which is never moved or freed. The cgo
+// pointer rules apply to such memory as before.
+func (p *Pinner) Pin(pointer interface{}) {
+	if p.pinner == nil {
+		mp := acquirem()
+		if pp := mp.p.ptr(); pp != nil {
+			p.pinner = pp.pinnerCache
+			pp.pinnerCache = nil
+		}
+		releasem(mp)
+
+		if p.pinner == nil {
+			// The finalizer stays set while the pinner is
+			// reused from the cache, so it must allow for an
+			// empty pinner.
+			p.pinner = new(pinner)
+			SetFinalizer(p.pinner, func(i *pinner) {
+				if len(i.refs) != 0 {
+					i.unpin()
+					pinnerLeakPanic()
+				}
+			})
+		}
+	}
+	ptr := pinnerGetPtr(&pointer)
+	if setPinned(ptr, true) {
+		p.refs = append(p.refs, ptr)
+	}
+}
+
+// Unpin unpins all the objects pinned by p. C code must not use
+// pointers to them afterward.
+func (p *Pinner) Unpin() {
+	p.pinner.unpin()
+
+	mp := acquirem()
+	if pp := mp.p.ptr(); pp != nil && pp.pinnerCache == nil {
+		// Only fill an empty cache: a program that reuses its
+		// own Pinners is better off keeping their refs.
+		pp.pinnerCache = p.pinner
+		p.pinner = nil
+	}
+	releasem(mp)
+}
+
+func (p *pinner) unpin() {
+	if p == nil {
+		return
+	}
+	for i, ptr := range p.refs {
+		setPinned(ptr, false)
+		p.refs[i] = nil
+	}
+	p.refs = p.refs[:0]
+}
+
+// pinnerLeakPanic is called when a Pinner that still pins objects is
+// finalized. It is a variable for testing.
+var pinnerLeakPanic = func() {
+	panic(errorString("runtime.Pinner: found leaking pinned pointer; forgot to call Unpin()?"))
+}
+
+func pinnerGetPtr(i *interface{}) unsafe.Pointer {
+	e := efaceOf(i)
+	etyp := e._type
+	if etyp == nil {
+		panic(errorString("runtime.Pinner: argument is nil"))
+	}
+	if kind := etyp.kind & kindMask; kind != kindPtr && kind != kindUnsafePointer {
+		panic(errorString("runtime.Pinner: argument is not a pointer: " + etyp.string()))
+	}
+	return e.data
+}
+
+// setPinned increments (pin) or decrements (!pin) the pin count of
+// the heap object containing ptr, which is kept in a special record.
+// It reports whether ptr points into the heap. The record only marks
+// the object; the Pinner's reference to it is what keeps it alive.
+func setPinned(ptr unsafe.Pointer, pin bool) bool {
+	base, span, _ := findObject(uintptr(ptr), 0, 0)
+	if base == 0 {
+		if !pin {
+			throw("runtime.Pinner: unpin of non-heap pointer")
+		}
+		return false
+	}
+
+	var s *specialpin
+	if pin {
+		lock(&mheap_.speciallock)
+		s = (*specialpin)(mheap_.specialpinalloc.alloc())
+		unlock(&mheap_.speciallock)
+	}
+
+	// See addspecial.
+	mp := acquirem()
+	span.ensureSwept()
+
+	offset := uint16(base - span.base())
+
+	lock(&span.speciallock)
+	t := &span.specials
+	for *t != nil && ((*t).offset < offset || (*t).offset == offset && (*t).kind < _KindSpecialPin) {
+		t = &(*t).next
+	}
+	var sp *specialpin
+	if x := *t; x != nil && x.offset == offset && x.kind == _KindSpecialPin {
+		sp = (*specialpin)(unsafe.Pointer(x))
+	}
+	switch {
+	case pin && sp == nil:
+		s.special.kind = _KindSpecialPin
+		s.special.offset = offset
+		s.special.next = *t
+		s.count = 1
+		*t = &s.special
+		s = nil
+	case pin:
+		sp.count++
+	case sp == nil:
+		unlock(&span.speciallock)
+		releasem(mp)
+		throw("runtime.Pinner: object already unpinned")
+	default:
+		sp.count--
+		if sp.count == 0 {
+			*t = sp.special.next
+			s = sp
+		}
+	}
+	unlock(&span.speciallock)
+	releasem(mp)
+
+	if s != nil {
+		lock(&mheap_.speciallock)
+		mheap_.specialpinalloc.free(unsafe.Pointer(s))
+		unlock(&mheap_.speciallock)
+	}
+	return true
+}
+
+// isPinned reports whether ptr points into a heap object pinned by a
+// Pinner.
+//
+// It does not sweep the span, since it is called from the write
+// barrier, where sweeping is not allowed. That is safe because the
+// sweeper only removes the records of dead objects, and does so
+// under span.speciallock.
+//
+//go:nowritebarrierrec
+func isPinned(ptr unsafe.Pointer) bool {
+	base, span, _ := findObject(uintptr(ptr), 0, 0)
+	if base == 0 {
+		return false
+	}
+
+	offset := uint16(base - span.base())
+	pinned := false
+
+	lock(&span.speciallock)
+	for x := span.specials; x != nil && x.offset <= offset; x = x.next {
+		if x.offset == offset && x.kind == _KindSpecialPin {
+			pinned = true
+			break
+		}
+	}
+	unlock(&span.speciallock)
+	return pinned
+}
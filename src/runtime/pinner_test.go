@@ -0,0 +1,166 @@
+// Copyright 2018 The Go Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+package runtime_test
+
+import (
+	"runtime"
+	"testing"
+	"time"
+	"unsafe"
+)
+
+type pinnerObj struct {
+	x int
+	p *int
+}
+
+func TestPinnerPin(t *testing.T) {
+	var pinner runtime.Pinner
+	p := new(pinnerObj)
+	if runtime.IsPinned(unsafe.Pointer(p)) {
+		t.Fatal("object pinned before Pin")
+	}
+	pinner.Pin(p)
+	if !runtime.IsPinned(unsafe.Pointer(p)) {
+		t.Fatal("object not pinned after Pin")
+	}
+	if !runtime.IsPinned(unsafe.Pointer(&p.p)) {
+		t.Fatal("interior pointer not pinned")
+	}
+	runtime.GC()
+	if !runtime.IsPinned(unsafe.Pointer(p)) {
+		t.Fatal("object not pinned after GC")
+	}
+	pinner.Unpin()
+	if runtime.IsPinned(unsafe.Pointer(p)) {
+		t.Fatal("object pinned after Unpin")
+	}
+}
+
+func TestPinnerInterior(t *testing.T) {
+	var pinner runtime.Pinner
+	b := make([]byte, 4096)
+	pinner.Pin(&b[100])
+	if !runtime.IsPinned(unsafe.Pointer(&b[0])) || !runtime.IsPinned(unsafe.Pointer(&b[4095])) {
+		t.Error("pinning an element did not pin the whole object")
+	}
+	pinner.Unpin()
+	if runtime.IsPinned(unsafe.Pointer(&b[0])) {
+		t.Error("object pinned after Unpin")
+	}
+}
+
+func TestPinnerTwice(t *testing.T) {
+	var pinner1, pinner2 runtime.Pinner
+	p := new(pinnerObj)
+	pinner1.Pin(p)
+	pinner1.Pin(p)
+	pinner2.Pin(&p.x)
+	pinner1.Unpin()
+	if !runtime.IsPinned(unsafe.Pointer(p)) {
+		t.Fatal("object not pinned while a second Pinner pins it")
+	}
+	pinner2.Unpin()
+	if runtime.IsPinned(unsafe.Pointer(p)) {
+		t.Fatal("object pinned after both Pinners unpinned it")
+	}
+}
+
+func TestPinnerReuse(t *testing.T) {
+	var pinner runtime.Pinner
+	for i := 0; i < 3; i++ {
+		p := new(pinnerObj)
+		pinner.Pin(p)
+		if !runtime.IsPinned(unsafe.Pointer(p)) {
+			t.Fatalf("object not pinned in round %d", i)
+		}
+		pinner.Unpin()
+	}
+}
+
+func TestPinnerManyObjects(t *testing.T) {
+	// Tiny and small objects sharing spans, and a large object,
+	// exercise the ordering of special records within a span.
+	var pinner runtime.Pinner
+	var objs []*pinnerObj
+	for i := 0; i < 1000; i++ {
+		objs = append(objs, new(pinnerObj))
+	}
+	for i := 0; i < len(objs); i += 2 {
+		pinner.Pin(objs[i])
+		runtime.SetFinalizer(objs[i], func(*pinnerObj) {})
+	}
+	large := make([]byte, 1<<20)
+	pinner.Pin(&large[0])
+	runtime.GC()
+	for i, o := range objs {
+		if got, want := runtime.IsPinned(unsafe.Pointer(o)), i%2 == 0; got != want {
+			t.Fatalf("object %d: IsPinned = %v, want %v", i, got, want)
+		}
+	}
+	if !runtime.IsPinned(unsafe.Pointer(&large[0])) {
+		t.Fatal("large object not pinned")
+	}
+	pinner.Unpin()
+	for i, o := range objs {
+		if runtime.IsPinned(unsafe.Pointer(o)) {
+			t.Fatalf("object %d pinned after Unpin", i)
+		}
+	}
+}
+
+var pinnerGlobal int
+
+func TestPinnerNonHeap(t *testing.T) {
+	var pinner runtime.Pinner
+	pinner.Pin(&pinnerGlobal)
+	if runtime.IsPinned(unsafe.Pointer(&pinnerGlobal)) {
+		t.Error("global variable reported as pinned")
+	}
+	pinner.Unpin()
+}
+
+func TestPinnerBadArgument(t *testing.T) {
+	for _, arg := range []interface{}{nil, 1, "x", []byte{1}} {
+		func() {
+			defer func() {
+				if recover() == nil {
+					t.Errorf("Pin(%#v) did not panic", arg)
+				}
+			}()
+			var pinner runtime.Pinner
+			pinner.Pin(arg)
+		}()
+	}
+}
+
+func TestPinnerLeakPanics(t *testing.T) {
+	leaked := make(chan bool, 1)
+	old := runtime.SetPinnerLeakPanic(func() { leaked <- true })
+	defer runtime.SetPinnerLeakPanic(old)
+
+	func() {
+		var pinner runtime.Pinner
+		pinner.Pin(new(pinnerObj))
+	}()
+	for i := 0; i < 10; i++ {
+		runtime.GC()
+		select {
+		case <-leaked:
+			return
+		case <-time.After(100 * time.Millisecond):
+		}
+	}
+	t.Fatal("leaked Pinner was not reported")
+}
+
+func BenchmarkPinnerPinUnpin(b *testing.B) {
+	p := new(pinnerObj)
+	var pinner runtime.Pinner
+	for i := 0; i < b.N; i++ {
+		pinner.Pin(p)
+		pinner.Unpin()
+	}
+}
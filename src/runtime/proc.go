@@ -550,6 +550,9 @@ func schedinit() {
 	goargs()
 	goenvs()
 	parsedebugvars()
+	if raceenabled {
+		racesample(debug.racesample)
+	}
 	gcinit()
 
 	sched.lastpoll = uint64(nanotime())
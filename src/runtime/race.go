@@ -291,6 +291,11 @@ var racedataend uintptr
 var racearenastart uintptr
 var racearenaend uintptr
 
+// If racesamplelimit is not zero, racecalladdr in race_amd64.s only
+// passes on accesses to the 64-byte blocks of memory whose address hashes
+// to less than racesamplelimit, out of 1<<32.
+var racesamplelimit uint64
+
 func racefuncenter(uintptr)
 func racefuncenterfp()
 func racefuncexit()
@@ -353,6 +358,17 @@ func raceinit() (gctx, pctx uintptr) {
 	return
 }
 
+// racesample sets the percentage of memory whose accesses are checked,
+// from GODEBUG=racesample=N. Any other value than 0 < N < 100 checks all
+// memory. Synchronization events are not sampled, so the happens-before
+// relation stays exact and races between checked accesses are reported
+// as without sampling.
+func racesample(percent int32) {
+	if 0 < percent && percent < 100 {
+		racesamplelimit = uint64(percent) << 32 / 100
+	}
+}
+
 var raceFiniLock mutex
 
 //go:nosplit
@@ -17,6 +17,7 @@ import (
 	"fmt"
 	"internal/testenv"
 	"io"
+	"io/ioutil"
 	"log"
 	"math/rand"
 	"os"
@@ -150,6 +151,15 @@ func runTests(t *testing.T) ([]byte, error) {
 	args := []string{"test", "-race", "-v"}
 	args = append(args, tests...)
 	cmd := exec.Command(testenv.GoToolPath(t), args...)
+	setTestEnv(cmd)
+	// There are races: we expect tests to fail and the exit code to be non-zero.
+	out, _ := cmd.CombinedOutput()
+	return out, nil
+}
+
+// setTestEnv sets the environment of cmd, which runs the tests in
+// testdata.
+func setTestEnv(cmd *exec.Cmd) {
 	// The following flags turn off heuristics that suppress seemingly identical reports.
 	// It is required because the tests contain a lot of data races on the same addresses
 	// (the tests are simple and the memory is constantly reused).
@@ -175,9 +185,68 @@ func runTests(t *testing.T) ([]byte, error) {
 		"GOMAXPROCS=1",
 		"GORACE=suppress_equal_stacks=0 suppress_equal_addresses=0",
 	)
-	// There are races: we expect tests to fail and the exit code to be non-zero.
+}
+
+// buildTests builds the tests in testdata into a binary in dir.
+func buildTests(tb testing.TB, dir string) string {
+	tests, err := filepath.Glob("./testdata/*_test.go")
+	if err != nil {
+		tb.Fatal(err)
+	}
+	exe := filepath.Join(dir, "race.test")
+	args := []string{"test", "-c", "-race", "-o", exe}
+	args = append(args, tests...)
+	if out, err := exec.Command(testenv.GoToolPath(tb), args...).CombinedOutput(); err != nil {
+		tb.Fatalf("go test -c -race: %v\n%s", err, out)
+	}
+	return exe
+}
+
+// runSampled runs the test binary exe with GODEBUG=racesample=percent
+// and returns the number of Race tests in which a race was reported,
+// the number of Race tests, and the number of NoRace tests in which
+// a race was reported.
+func runSampled(exe string, percent int) (found, racy, falsePos int) {
+	cmd := exec.Command(exe, "-test.v")
+	setTestEnv(cmd)
+	cmd.Env = append(cmd.Env, fmt.Sprintf("GODEBUG=racesample=%d", percent))
 	out, _ := cmd.CombinedOutput()
-	return out, nil
+	for _, test := range strings.Split(string(out), testPrefix)[1:] {
+		gotRace := strings.Contains(test, "DATA RACE")
+		switch {
+		case strings.HasPrefix(test, "Race"):
+			racy++
+			if gotRace {
+				found++
+			}
+		case strings.HasPrefix(test, "NoRace"):
+			if gotRace {
+				falsePos++
+			}
+		}
+	}
+	return
+}
+
+func TestRaceSample(t *testing.T) {
+	if testing.Short() {
+		t.Skip("skipping in short mode")
+	}
+	dir, err := ioutil.TempDir("", "race-sample")
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer os.RemoveAll(dir)
+	exe := buildTests(t, dir)
+	all, racy, _ := runSampled(exe, 100)
+	found, racy, falsePos := runSampled(exe, 10)
+	t.Logf("racesample=10: detected %d of %d races, %d without sampling", found, racy, all)
+	if falsePos > 0 {
+		t.Errorf("racesample=10: %d false positives", falsePos)
+	}
+	if found >= all {
+		t.Errorf("racesample=10: detected %d races, want fewer than the %d without sampling", found, all)
+	}
 }
 
 func TestIssue8102(t *testing.T) {
@@ -204,6 +273,28 @@ func TestIssue9137(t *testing.T) {
 	}
 }
 
+// BenchmarkRaceSample runs the tests in testdata at several settings of
+// GODEBUG=racesample and logs how many of their races are detected.
+func BenchmarkRaceSample(b *testing.B) {
+	dir, err := ioutil.TempDir("", "race-sample")
+	if err != nil {
+		b.Fatal(err)
+	}
+	defer os.RemoveAll(dir)
+	exe := buildTests(b, dir)
+	for _, percent := range []int{100, 50, 10, 1} {
+		b.Run(fmt.Sprint(percent), func(b *testing.B) {
+			var found, racy int
+			for i := 0; i < b.N; i++ {
+				f, r, _ := runSampled(exe, percent)
+				found += f
+				racy += r
+			}
+			b.Logf("detected %d of %d races", found, racy)
+		})
+	}
+}
+
 func BenchmarkSyncLeak(b *testing.B) {
 	const (
 		G = 1000
@@ -154,6 +154,19 @@ data:
 	CMPQ	RARG1, runtime·racedataend(SB)
 	JAE	ret
 call:
+	// With GODEBUG=racesample=N, check only the 64-byte blocks whose
+	// hash is below racesamplelimit.
+	MOVQ	runtime·racesamplelimit(SB), R13
+	TESTQ	R13, R13
+	JZ	sampled
+	MOVQ	RARG1, R11
+	SHRQ	$6, R11
+	MOVQ	$0x9e3779b97f4a7c15, R10
+	IMULQ	R10, R11
+	SHRQ	$32, R11
+	CMPQ	R11, R13
+	JAE	ret
+sampled:
 	MOVQ	AX, AX		// w/o this 6a miscompiles this function
 	JMP	racecall<>(SB)
 ret:
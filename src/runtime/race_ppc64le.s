@@ -153,6 +153,18 @@ data:
 	CMP	R4, R9
 	BGT	ret
 call:
+	// With GODEBUG=racesample=N, check only the 64-byte blocks whose
+	// hash is below racesamplelimit.
+	MOVD	runtime·racesamplelimit(SB), R9
+	CMP	R9, $0
+	BEQ	sampled
+	SRD	$6, R4, R10
+	MOVD	$0x9e3779b97f4a7c15, R11
+	MULLD	R11, R10
+	SRD	$32, R10
+	CMPU	R10, R9
+	BGE	ret
+sampled:
 	// Careful!! racecall will save LR on its
 	// stack, which is OK as long as racecalladdr
 	// doesn't change in a way that generates a stack.
@@ -315,6 +315,7 @@ type dbgVar struct {
 // already have an initial value.
 var debug struct {
 	allocfreetrace     int32
+	cgoasyncthreads    int32
 	cgocheck           int32
 	efence             int32
 	gccheckmark        int32
@@ -324,6 +325,7 @@ var debug struct {
 	gcstoptheworld     int32
 	gctrace            int32
 	invalidptr         int32
+	racesample         int32
 	sbrk               int32
 	scavenge           int32
 	scheddetail        int32
@@ -333,6 +335,7 @@ var debug struct {
 
 var dbgvars = []dbgVar{
 	{"allocfreetrace", &debug.allocfreetrace},
+	{"cgoasyncthreads", &debug.cgoasyncthreads},
 	{"cgocheck", &debug.cgocheck},
 	{"efence", &debug.efence},
 	{"gccheckmark", &debug.gccheckmark},
@@ -342,6 +345,7 @@ var dbgvars = []dbgVar{
 	{"gcstoptheworld", &debug.gcstoptheworld},
 	{"gctrace", &debug.gctrace},
 	{"invalidptr", &debug.invalidptr},
+	{"racesample", &debug.racesample},
 	{"sbrk", &debug.sbrk},
 	{"scavenge", &debug.scavenge},
 	{"scheddetail", &debug.scheddetail},
@@ -526,6 +526,10 @@ type p struct {
 
 	palloc persistentAlloc // per-P to avoid mutex
 
+	// pinnerCache is a pinner released by Pinner.Unpin, kept for
+	// the next Pinner to save setting up its finalizer.
+	pinnerCache *pinner
+
 	// Per-P GC state
 	gcAssistTime         int64 // Nanoseconds in assistAlloc
 	gcFractionalMarkTime int64 // Nanoseconds in fractional mark worker
@@ -788,6 +792,7 @@ const (
 	waitReasonTraceReaderBlocked                      // "trace reader (blocked)"
 	waitReasonWaitForGCCycle                          // "wait for GC cycle"
 	waitReasonGCWorkerIdle                            // "GC worker (idle)"
+	waitReasonCgoAsync                                // "cgo call (async)"
 )
 
 var waitReasonStrings = [...]string{
@@ -815,6 +820,7 @@ var waitReasonStrings = [...]string{
 	waitReasonTraceReaderBlocked:    "trace reader (blocked)",
 	waitReasonWaitForGCCycle:        "wait for GC cycle",
 	waitReasonGCWorkerIdle:          "GC worker (idle)",
+	waitReasonCgoAsync:              "cgo call (async)",
 }
 
 func (w waitReason) String() string {
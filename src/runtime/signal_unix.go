@@ -53,6 +53,11 @@ var fwdSig [_NSIG]uintptr
 // This is uint32 rather than bool so that we can use atomic instructions.
 var handlingSig [_NSIG]uint32
 
+// forwardingSig is indexed by signal number and is non-zero if
+// os/signal.Forward was called for the signal, so that Go leaves it to
+// the handler that was installed before Go's, if any.
+var forwardingSig [_NSIG]uint32
+
 // channels for synchronizing signal mask updates with the signal mask
 // thread
 var (
@@ -117,6 +122,10 @@ func initsig(preinit bool) {
 //go:nosplit
 //go:nowritebarrierrec
 func sigInstallGoHandler(sig uint32) bool {
+	if atomic.Load(&forwardingSig[sig]) != 0 {
+		return false
+	}
+
 	// For some signals, we respect an inherited SIG_IGN handler
 	// rather than insist on installing our own default handler.
 	// Even these signals can be fetched using the os/signal package.
@@ -159,6 +168,7 @@ func sigenable(sig uint32) {
 		ensureSigM()
 		enableSigChan <- sig
 		<-maskUpdatedChan
+		atomic.Store(&forwardingSig[sig], 0)
 		if atomic.Cas(&handlingSig[sig], 0, 1) {
 			atomic.Storeuintptr(&fwdSig[sig], getsig(sig))
 			setsig(sig, funcPC(sighandler))
@@ -210,11 +220,42 @@ func sigignore(sig uint32) {
 
 	t := &sigtable[sig]
 	if t.flags&_SigNotify != 0 {
+		atomic.Store(&forwardingSig[sig], 0)
 		atomic.Store(&handlingSig[sig], 0)
 		setsig(sig, _SIG_IGN)
 	}
 }
 
+// sigforward reinstalls the handler that Go found for sig when it
+// installed its own, or the default action, so that sig no longer
+// goes through the Go signal handler at all. Unlike sigdisable, this
+// applies to signals that initsig does install a handler for.
+func sigforward(sig uint32) {
+	if sig >= uint32(len(sigtable)) {
+		return
+	}
+
+	// SIGPROF is handled specially for profiling.
+	if sig == _SIGPROF {
+		return
+	}
+
+	t := &sigtable[sig]
+	if t.flags&_SigNotify != 0 {
+		ensureSigM()
+		disableSigChan <- sig
+		<-maskUpdatedChan
+
+		atomic.Store(&forwardingSig[sig], 1)
+		atomic.Store(&handlingSig[sig], 0)
+		fwdFn := atomic.Loaduintptr(&fwdSig[sig])
+		setsig(sig, fwdFn)
+		if fwdFn == _SIG_IGN {
+			sigInitIgnored(sig)
+		}
+	}
+}
+
 // clearSignalHandlers clears all signal handlers that are not ignored
 // back to the default. This is called by the child after a fork, so that
 // we can enable the signal mask for the exec without worrying about
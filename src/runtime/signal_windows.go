@@ -246,6 +246,9 @@ func sigdisable(sig uint32) {
 func sigignore(sig uint32) {
 }
 
+func sigforward(sig uint32) {
+}
+
 func badsignal2()
 
 func raisebadsignal(sig uint32) {
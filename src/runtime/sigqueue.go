@@ -237,6 +237,25 @@ func signal_ignore(s uint32) {
 	atomic.Store(&sig.ignored[s/32], i)
 }
 
+// Must only be called from a single goroutine at a time.
+//go:linkname signal_forward os/signal.signal_forward
+func signal_forward(s uint32) {
+	if s >= uint32(len(sig.wanted)*32) {
+		return
+	}
+
+	// sigforward marks s ignored again if it is ignored after all.
+	i := sig.ignored[s/32]
+	i &^= 1 << (s & 31)
+	atomic.Store(&sig.ignored[s/32], i)
+
+	sigforward(s)
+
+	w := sig.wanted[s/32]
+	w &^= 1 << (s & 31)
+	atomic.Store(&sig.wanted[s/32], w)
+}
+
 // sigInitIgnored marks the signal as already ignored.  This is called at
 // program start by siginit.
 func sigInitIgnored(s uint32) {
@@ -1096,6 +1096,11 @@ func shrinkstack(gp *g) {
 	if sys.GoosWindows != 0 && gp.m != nil && gp.m.libcallsp != 0 {
 		return
 	}
+	// Nor while a C worker thread may write the results of an
+	// asynchronous cgo call to the stack.
+	if readgstatus(gp)&^_Gscan == _Gwaiting && gp.waitreason == waitReasonCgoAsync {
+		return
+	}
 
 	if stackDebug > 0 {
 		print("shrinking stack ", oldsize, "->", newsize, "\n")
@@ -73,6 +73,22 @@ func Setenv(key, value string) error {
 	return nil
 }
 
+// UpdateEnv unsets the keys in unset and then sets the keys in set to
+// their values, as if by calls to Unsetenv and Setenv.
+func UpdateEnv(set map[string]string, unset []string) error {
+	for _, key := range unset {
+		if err := Unsetenv(key); err != nil {
+			return err
+		}
+	}
+	for key, value := range set {
+		if err := Setenv(key, value); err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
 func Clearenv() {
 	RawSyscall(SYS_RFORK, RFCENVG, 0, 0)
 }
@@ -33,6 +33,10 @@ func runtime_envs() []string // in package runtime
 func setenv_c(k, v string)
 func unsetenv_c(k string)
 
+// updateenv_c is provided by the runtime but is a no-op if cgo isn't
+// loaded. set holds "key=value" strings.
+func updateenv_c(set, unset []string)
+
 func copyenv() {
 	env = make(map[string]int)
 	for i, s := range envs {
@@ -90,21 +94,29 @@ func Getenv(key string) (value string, found bool) {
 	return "", false
 }
 
-func Setenv(key, value string) error {
-	envOnce.Do(copyenv)
+// validEnv reports whether Setenv accepts key and value.
+func validEnv(key, value string) bool {
 	if len(key) == 0 {
-		return EINVAL
+		return false
 	}
 	for i := 0; i < len(key); i++ {
 		if key[i] == '=' || key[i] == 0 {
-			return EINVAL
+			return false
 		}
 	}
 	for i := 0; i < len(value); i++ {
 		if value[i] == 0 {
-			return EINVAL
+			return false
 		}
 	}
+	return true
+}
+
+func Setenv(key, value string) error {
+	envOnce.Do(copyenv)
+	if !validEnv(key, value) {
+		return EINVAL
+	}
 
 	envLock.Lock()
 	defer envLock.Unlock()
@@ -122,6 +134,44 @@ func Setenv(key, value string) error {
 	return nil
 }
 
+// UpdateEnv unsets the keys in unset and then sets the keys in set to
+// their values, as if by calls to Unsetenv and Setenv, but updates the
+// C environment of a program using cgo in a single C call. If a key or
+// value is invalid, UpdateEnv returns EINVAL and changes nothing.
+func UpdateEnv(set map[string]string, unset []string) error {
+	envOnce.Do(copyenv)
+	for key, value := range set {
+		if !validEnv(key, value) {
+			return EINVAL
+		}
+	}
+
+	envLock.Lock()
+	defer envLock.Unlock()
+
+	for _, key := range unset {
+		if i, ok := env[key]; ok {
+			envs[i] = ""
+			delete(env, key)
+		}
+	}
+	kvs := make([]string, 0, len(set))
+	for key, value := range set {
+		i, ok := env[key]
+		kv := key + "=" + value
+		if ok {
+			envs[i] = kv
+		} else {
+			i = len(envs)
+			envs = append(envs, kv)
+		}
+		env[key] = i
+		kvs = append(kvs, kv)
+	}
+	updateenv_c(kvs, unset)
+	return nil
+}
+
 func Clearenv() {
 	envOnce.Do(copyenv) // prevent copyenv in Getenv/Setenv
 
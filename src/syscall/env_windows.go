@@ -53,6 +53,22 @@ func Unsetenv(key string) error {
 	return SetEnvironmentVariable(keyp, nil)
 }
 
+// UpdateEnv unsets the keys in unset and then sets the keys in set to
+// their values, as if by calls to Unsetenv and Setenv.
+func UpdateEnv(set map[string]string, unset []string) error {
+	for _, key := range unset {
+		if err := Unsetenv(key); err != nil {
+			return err
+		}
+	}
+	for key, value := range set {
+		if err := Setenv(key, value); err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
 func Clearenv() {
 	for _, s := range Environ() {
 		// Environment variables can begin with =